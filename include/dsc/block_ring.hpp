@@ -0,0 +1,419 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "dsc/index_iterator.hpp"
+#include "dsc/ring_vector.hpp"
+
+namespace dsc {
+
+/** Default block size for block_ring: a power of 2 number of elements filling about 4 KB, with a minimum of 16 */
+template<typename T>
+inline constexpr std::size_t default_block_size = std::max<std::size_t>(std::bit_floor(4096 / sizeof(T)), 16);
+
+/** Double ended queue built from fixed size blocks, with a ring_vector of block pointers as its map. Growing at either
+ *  end allocates at most one block and never moves existing elements, so references to elements stay valid across
+ *  push and pop at either end. Only insert, which has to shift elements, invalidates them. */
+template<typename T, typename Allocator = std::allocator<T>, std::size_t BlockSize = default_block_size<T>>
+class block_ring {
+    static_assert(std::has_single_bit(BlockSize), "BlockSize must be a power of 2");
+
+    using ui32        = std::size_t;
+    using allc_tr     = std::allocator_traits<Allocator>;
+    using block_alloc = typename allc_tr::template rebind_alloc<T*>;
+
+    static constexpr ui32 block_shift = std::countr_zero(BlockSize);
+    static constexpr ui32 block_mask  = BlockSize - 1;
+
+    Allocator                       alloc_;
+    ring_vector<T*, block_alloc>    blocks_;
+    T*                              spare_;
+    ui32                            offset_,
+                                    size_;
+
+    /** Returns a free block, reusing the spare block if there is one */
+    auto take_block() -> T* {
+        if (spare_) {
+            return std::exchange(spare_, nullptr);
+        }
+        return allc_tr::allocate(alloc_, BlockSize);
+    }
+
+    /** Keeps an emptied block as the spare, or deallocates it if there already is one */
+    auto release_block(T* block) -> void {
+        if (spare_) {
+            allc_tr::deallocate(alloc_, block, BlockSize);
+        } else {
+            spare_ = block;
+        }
+    }
+
+    /** Returns the slot of the element at the given position */
+    auto slot(ui32 pos) const -> T* {
+        ui32 idx = offset_ + pos;
+        return blocks_[idx >> block_shift] + (idx & block_mask);
+    }
+
+    /** Destroys all elements and deallocates every block */
+    auto destroy() -> void {
+        clear();
+        while (!blocks_.empty()) {
+            allc_tr::deallocate(alloc_, blocks_.pop_back_get(), BlockSize);
+        }
+        if (spare_) {
+            allc_tr::deallocate(alloc_, spare_, BlockSize);
+            spare_ = nullptr;
+        }
+    }
+
+ public:
+    using value_type        = T;
+    using allocator_type    = Allocator;
+    using size_type         = ui32;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+    using pointer           = value_type*;
+    using const_pointer     = const value_type*;
+
+    /** Constructs an empty block ring. No blocks are allocated until the first element is added. */
+    block_ring(): block_ring(Allocator()) {}
+
+    /** Constructs an empty block ring which allocates its blocks and its map through alloc */
+    explicit block_ring(Allocator const& alloc): alloc_(alloc),
+                                                 blocks_(block_alloc(alloc_)),
+                                                 spare_(nullptr),
+                                                 offset_(0),
+                                                 size_(0) {}
+
+    /** Copy constructor which copies all elements over with T's copy constructor. The allocator is chosen by
+     *  select_on_container_copy_construction. */
+    block_ring(block_ring const& other): block_ring(other, allc_tr::select_on_container_copy_construction(other.alloc_)) {}
+
+    /** Copy constructor which allocates through alloc */
+    block_ring(block_ring const& other, Allocator const& alloc): block_ring(alloc) {
+        for (ui32 idx=0; idx < other.size_; idx++) {
+            push_back(other[idx]);
+        }
+    }
+
+    /** Move constructor which takes all blocks and the allocator of the other block ring and leaves it empty */
+    block_ring(block_ring&& other) noexcept: alloc_(std::move(other.alloc_)),
+                                             blocks_(std::move(other.blocks_)),
+                                             spare_(std::exchange(other.spare_, nullptr)),
+                                             offset_(std::exchange(other.offset_, 0)),
+                                             size_(std::exchange(other.size_, 0)) {}
+
+    /** Move constructor which allocates through alloc. Takes other's blocks if alloc compares equal to other's
+     *  allocator, otherwise moves each element into new blocks. */
+    block_ring(block_ring&& other, Allocator const& alloc): block_ring(alloc) {
+        if (alloc_ == other.alloc_) {
+            blocks_ = std::move(other.blocks_);
+            spare_  = std::exchange(other.spare_, nullptr);
+            offset_ = std::exchange(other.offset_, 0);
+            size_   = std::exchange(other.size_, 0);
+        } else {
+            for (ui32 idx=0; idx < other.size_; idx++) {
+                push_back(std::move(other[idx]));
+            }
+            other.clear();
+        }
+    }
+
+    ~block_ring() {
+        destroy();
+    }
+
+    /** Replaces the contents with a copy of other. The allocator is replaced by other's only if
+     *  propagate_on_container_copy_assignment is set. */
+    auto operator=(block_ring const& other) -> block_ring& {
+        if (this == &other) {
+            return *this;
+        }
+
+        destroy();
+        if constexpr (allc_tr::propagate_on_container_copy_assignment::value) {
+            alloc_  = other.alloc_;
+            blocks_ = ring_vector<T*, block_alloc>(block_alloc(alloc_));
+        }
+        for (ui32 idx=0; idx < other.size_; idx++) {
+            push_back(other[idx]);
+        }
+
+        return *this;
+    }
+
+    /** Replaces the contents with those of other, leaving other empty. other's blocks are taken over when the
+     *  allocator propagates on move assignment or the allocators compare equal, otherwise each element is moved into
+     *  new blocks from this ring's allocator. */
+    auto operator=(block_ring&& other) -> block_ring& {
+        if (this == &other) {
+            return *this;
+        }
+
+        destroy();
+        if (allc_tr::propagate_on_container_move_assignment::value || alloc_ == other.alloc_) {
+            if constexpr (allc_tr::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(other.alloc_);
+            }
+            blocks_ = std::move(other.blocks_);
+            spare_  = std::exchange(other.spare_, nullptr);
+            offset_ = std::exchange(other.offset_, 0);
+            size_   = std::exchange(other.size_, 0);
+        } else {
+            for (ui32 idx=0; idx < other.size_; idx++) {
+                push_back(std::move(other[idx]));
+            }
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    /** Swaps contents with other. Allocators are swapped only if propagate_on_container_swap is set, otherwise
+     *  they must compare equal. */
+    auto swap(block_ring& other) -> void {
+        if constexpr (allc_tr::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
+        blocks_.swap(other.blocks_);
+        std::swap(spare_,  other.spare_);
+        std::swap(offset_, other.offset_);
+        std::swap(size_,   other.size_);
+    }
+
+    /** Returns a copy of the allocator */
+    auto get_allocator() const -> allocator_type { return alloc_; }
+
+
+    /* ========================================================== */
+    /* ====================  ELEMENT ACCESS  ==================== */
+
+    /** Returns reference to an element at the given position */
+    auto at(ui32 pos)       -> reference       { return *slot(pos); }
+    /** Returns const reference to an element at the given position */
+    auto at(ui32 pos) const -> const_reference { return *slot(pos); }
+
+    /** Returns reference to an element at the given position */
+    auto operator[](ui32 pos)       -> reference       { return *slot(pos); }
+    /** Returns const reference to an element at the given position */
+    auto operator[](ui32 pos) const -> const_reference { return *slot(pos); }
+
+    /** Returns reference to first element */
+    auto front()       -> reference       { return *slot(0); }
+    /** Returns const reference to first element */
+    auto front() const -> const_reference { return *slot(0); }
+
+    /** Returns reference to last element */
+    auto back()       -> reference       { return *slot(size_-1); }
+    /** Returns const reference to last element */
+    auto back() const -> const_reference { return *slot(size_-1); }
+
+
+    /* ========================================================== */
+    /* =======================  ITERATORS  ====================== */
+
+    using iterator       = index_iterator<block_ring, T>;
+    using const_iterator = index_iterator<block_ring, T const>;
+
+    /** Returns random access iterator starting at front */
+    auto begin() -> iterator { return {*this, 0}; }
+    /** Returns end position of random access iterator */
+    auto end()   -> iterator { return {*this, size_}; }
+
+    /** Returns const random access iterator starting at front */
+    auto begin() const -> const_iterator { return {*this, 0}; }
+    /** Returns end position of const random access iterator */
+    auto end()   const -> const_iterator { return {*this, size_}; }
+
+    /** Returns const random access iterator starting at front */
+    auto cbegin() const -> const_iterator { return {*this, 0}; }
+    /** Returns end position of const random access iterator */
+    auto cend()   const -> const_iterator { return {*this, size_}; }
+
+
+    /* ========================================================== */
+    /* =======================  SEGMENTS  ======================= */
+
+    /** Calls f on the elements of each block in order, as a span. If f returns a bool, stops as soon as f returns
+     *  false. Returns false if iteration was stopped early. */
+    template<typename F>
+    auto for_each_segment(F&& f) -> bool {
+        return visit_blocks<T>(*this, f);
+    }
+
+    /** Calls f on the elements of each block in order, as a const span. If f returns a bool, stops as soon as f returns
+     *  false. Returns false if iteration was stopped early. */
+    template<typename F>
+    auto for_each_segment(F&& f) const -> bool {
+        return visit_blocks<T const>(*this, f);
+    }
+
+ private:
+    template<typename V, typename Self, typename F>
+    static auto visit_blocks(Self& self, F& f) -> bool {
+        ui32 idx = self.offset_;
+        ui32 end = self.offset_ + self.size_;
+        while (idx < end) {
+            ui32 len     = std::min(BlockSize - (idx & block_mask), end - idx);
+            auto segment = std::span<V>{self.blocks_[idx >> block_shift] + (idx & block_mask), len};
+            if constexpr (std::is_same_v<std::invoke_result_t<F&, std::span<V>>, bool>) {
+                if (!f(segment)) {
+                    return false;
+                }
+            } else {
+                f(segment);
+            }
+            idx += len;
+        }
+        return true;
+    }
+
+ public:
+
+
+    /* ========================================================== */
+    /* ========================  CAPACITY  ====================== */
+
+    /** Returns true if there are no elements */
+    auto empty()    const -> bool { return size_ == 0; }
+
+    /** Returns number of elements */
+    auto size()     const -> ui32 { return size_; }
+
+    /** Returns number of elements which fit in the currently allocated blocks */
+    auto capacity() const -> ui32 { return blocks_.size() * BlockSize; }
+
+    /** Returns the number of elements per block */
+    static constexpr auto block_size() -> ui32 { return BlockSize; }
+
+
+    /* ========================================================== */
+    /* ========================  MODIFIERS  ===================== */
+
+    /** Remove all elements. Keeps at most one allocated block. */
+    auto clear() -> void {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (ui32 idx=0; idx < size_; idx++) {
+                allc_tr::destroy(alloc_, slot(idx));
+            }
+        }
+        while (!blocks_.empty()) {
+            release_block(blocks_.pop_back_get());
+        }
+        offset_ = 0;
+        size_   = 0;
+    }
+
+    /** Place one element at the end. Allocates a new block if the last block is full. */
+    auto push_back(T value) -> void {
+        emplace_back(std::move(value));
+    }
+
+    template<typename... Args>
+    auto emplace_back(Args&&... args) -> void {
+        if (offset_ + size_ == blocks_.size() * BlockSize) {
+            blocks_.push_back(take_block());
+        }
+        allc_tr::construct(alloc_, slot(size_), std::forward<Args>(args)...);
+        size_++;
+    }
+
+    /** Place one element at the beginning. Allocates a new block if the first block is full. */
+    auto push_front(T value) -> void {
+        emplace_front(std::move(value));
+    }
+
+    template<typename... Args>
+    auto emplace_front(Args&&... args) -> void {
+        if (offset_ == 0) {
+            blocks_.push_front(take_block());
+            offset_ = BlockSize;
+        }
+        allc_tr::construct(alloc_, blocks_[0] + (offset_ - 1), std::forward<Args>(args)...);
+        offset_--;
+        size_++;
+    }
+
+    /** Remove one element from the end. Releases the last block once it is empty. */
+    auto pop_back() -> void {
+        size_--;
+        allc_tr::destroy(alloc_, slot(size_));
+        if (((offset_ + size_) & block_mask) == 0) {
+            release_block(blocks_.pop_back_get());
+        }
+        if (size_ == 0) {
+            clear();
+        }
+    }
+
+    /** Remove one element from the end and return the element */
+    auto pop_back_get() -> T {
+        T temp = std::move(back());
+        pop_back();
+        return temp;
+    }
+
+    /** Remove one element from the beginning. Releases the first block once it is empty. */
+    auto pop_front() -> void {
+        allc_tr::destroy(alloc_, slot(0));
+        offset_++;
+        size_--;
+        if (offset_ == BlockSize) {
+            release_block(blocks_.pop_front_get());
+            offset_ = 0;
+        }
+        if (size_ == 0) {
+            clear();
+        }
+    }
+
+    /** Remove one element from the beginning and return the element */
+    auto pop_front_get() -> T {
+        T temp = std::move(front());
+        pop_front();
+        return temp;
+    }
+
+    /** Inserts value at pos, shifting whichever side of pos is shorter. Invalidates references to shifted elements. */
+    auto insert(ui32 pos, T value) -> iterator {
+        if (pos == 0) {
+            push_front(std::move(value));
+            return {*this, 0};
+        } else if (pos < size_/2) {
+            push_front(std::move(front()));
+            for (ui32 idx=1; idx < pos; idx++) {
+                (*this)[idx] = std::move((*this)[idx+1]);
+            }
+        } else if (pos < size_) {
+            push_back(std::move(back()));
+            for (ui32 idx=size_-2; idx > pos; idx--) {
+                (*this)[idx] = std::move((*this)[idx-1]);
+            }
+        } else {
+            push_back(std::move(value));
+            return {*this, pos};
+        }
+        (*this)[pos] = std::move(value);
+        return {*this, pos};
+    }
+};
+
+namespace pmr {
+
+/** block_ring which allocates its blocks and map from a std::pmr::memory_resource */
+template<typename T, std::size_t BlockSize = default_block_size<T>>
+using block_ring = dsc::block_ring<T, std::pmr::polymorphic_allocator<T>, BlockSize>;
+
+}  // namespace pmr
+
+}  // namespace dsc
@@ -0,0 +1,455 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dsc/kway_merge.hpp"
+#include "dsc/ring_vector.hpp"
+#include "dsc/safe_queue.hpp"
+
+namespace dsc {
+
+/** Limits and placement for external_sort */
+struct external_sort_options {
+    /** Bytes of record buffers used at any one time, in both the run and the merge phase */
+    std::size_t           memory_budget = std::size_t{256} << 20;
+    /** Threads sorting runs. Zero uses one per hardware thread. */
+    unsigned              threads = 0;
+    /** Directory for run files, which are unlinked as soon as they are created */
+    std::filesystem::path temp_dir = std::filesystem::temp_directory_path();
+    /** Smallest read buffer per run in a merge. When the budget cannot give every run this much, runs are merged in
+     *  more than one pass. */
+    std::size_t           min_block_bytes = std::size_t{1} << 20;
+};
+
+/** What external_sort did, and how fast */
+struct external_sort_stats {
+    std::uint64_t records       = 0;
+    std::uint64_t bytes         = 0;
+    std::size_t   runs          = 0;
+    /** Merges performed. Every merge but the last writes an intermediate run. */
+    std::size_t   merges        = 0;
+    double        run_seconds   = 0;
+    double        merge_seconds = 0;
+
+    /** Returns the total time spent sorting */
+    auto seconds() const -> double { return run_seconds + merge_seconds; }
+
+    /** Returns the sustained throughput over the whole sort, in megabytes of input per second */
+    auto mb_per_second() const -> double { return seconds() > 0 ? bytes / 1e6 / seconds() : 0; }
+};
+
+/** Sorts files of fixed size records which may be much larger than memory.
+ *
+ *  The run phase reads the input in chunks into ring_vector buffers, and a pool of threads sorts each chunk and
+ *  spills it to a temporary run file while the next chunks are read. The merge phase reads every run through two
+ *  buffers, refilling one on another thread while kway_merge consumes the other, and writes the output through two
+ *  buffers the same way. When there are too many runs for every one to get min_block_bytes of buffer, groups of runs
+ *  are merged into longer runs first. The sort is not stable. */
+template<typename T, typename Compare = std::less<>>
+requires std::is_trivially_copyable_v<T>
+class external_sorter {
+    using buffer_t = ring_vector<T>;
+    using clock    = std::chrono::steady_clock;
+
+    external_sort_options options_;
+    [[no_unique_address]] Compare comp_;
+
+    /** Returns the largest power of two no greater than bytes / sizeof(T), and at least 1 */
+    static auto records_in(std::size_t bytes) -> std::size_t {
+        return std::bit_floor(std::max<std::size_t>(bytes / sizeof(T), 1));
+    }
+
+    [[noreturn]] static auto fail(std::string const& what) -> void {
+        throw std::system_error(errno, std::generic_category(), "external_sort: " + what);
+    }
+
+    /** Owns a file descriptor, closing it when destroyed so run files are released when a sort fails */
+    class file {
+        int fd_ = -1;
+
+     public:
+        file() = default;
+        explicit file(int fd): fd_(fd) {}
+        file(file&& other) noexcept: fd_(std::exchange(other.fd_, -1)) {}
+
+        auto operator=(file&& other) noexcept -> file& {
+            if (this != &other) {
+                close();
+                fd_ = std::exchange(other.fd_, -1);
+            }
+            return *this;
+        }
+
+        ~file() { close(); }
+
+        auto get() const -> int { return fd_; }
+
+        /** Closes the descriptor, returning the result of ::close, or 0 if none was open */
+        auto close() -> int { return fd_ >= 0 ? ::close(std::exchange(fd_, -1)) : 0; }
+    };
+
+    /** Opens a file for reading or writing, throwing std::system_error on failure */
+    static auto open_file(std::filesystem::path const& path, int flags) -> file {
+        int fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            fail("cannot open " + path.string());
+        }
+        return file{fd};
+    }
+
+    /** Creates an anonymous file in temp_dir, unlinked so it disappears once closed */
+    auto make_temp() const -> file {
+        auto name = (options_.temp_dir / "dsc_sort_XXXXXX").string();
+        int  fd   = ::mkostemp(name.data(), O_CLOEXEC);
+        if (fd < 0) {
+            fail("cannot create a run file in " + options_.temp_dir.string());
+        }
+        ::unlink(name.c_str());
+        return file{fd};
+    }
+
+    /** Reads records from fd into the free space of buf until it is full or the file ends. Returns false once the
+     *  end of the file is reached. */
+    static auto fill(int fd, buffer_t& buf) -> bool {
+        std::size_t partial = 0;
+        while (buf.size() < buf.capacity()) {
+            auto [first, second] = buf.free_spans();
+            iovec iov[2] = {
+                {reinterpret_cast<std::byte*>(first.data()) + partial, first.size_bytes() - partial},
+                {second.data(), second.size_bytes()},
+            };
+            ssize_t got = ::readv(fd, iov, second.empty() ? 1 : 2);
+            if (got < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                fail("read failed");
+            }
+            if (got == 0) {
+                if (partial != 0) {
+                    throw std::runtime_error("external_sort: file size is not a multiple of the record size");
+                }
+                return false;
+            }
+            std::size_t bytes = partial + static_cast<std::size_t>(got);
+            buf.commit_back(bytes / sizeof(T));
+            partial = bytes % sizeof(T);
+        }
+        return true;
+    }
+
+    /** Writes every record of buf to fd and empties buf */
+    static auto drain(int fd, buffer_t& buf) -> void {
+        for (auto segment: {buf.as_spans().first, buf.as_spans().second}) {
+            auto const* data = reinterpret_cast<std::byte const*>(segment.data());
+            std::size_t left = segment.size_bytes();
+            while (left > 0) {
+                ssize_t put = ::write(fd, data, left);
+                if (put < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    fail("write failed");
+                }
+                data += put;
+                left -= static_cast<std::size_t>(put);
+            }
+        }
+        buf.clear();
+    }
+
+    /** Sorted run in a file, read back through two buffers as a single pass range. While the records of one buffer
+     *  are consumed the other is filled on another thread. */
+    class run_reader {
+        file              fd_;
+        buffer_t          current_;
+        buffer_t          next_;
+        std::future<bool> pending_;
+
+        auto prefetch(bool more) -> void {
+            if (more) {
+                pending_ = std::async(std::launch::async, [this] { return fill(fd_.get(), next_); });
+            }
+        }
+
+     public:
+        class iterator {
+            run_reader* run_ = nullptr;
+
+         public:
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = T;
+            using iterator_concept  = std::input_iterator_tag;
+
+            iterator() = default;
+            explicit iterator(run_reader& run): run_(&run) {}
+
+            auto operator*() const -> T const& { return run_->current_.front(); }
+
+            auto operator++()    -> iterator& { run_->advance(); return *this; }
+            auto operator++(int) -> void      { run_->advance(); }
+
+            friend auto operator==(iterator const& it, std::default_sentinel_t) -> bool {
+                return it.run_->empty();
+            }
+        };
+
+        /** Reads the run in fd from its start through buffers of block records, closing fd when destroyed */
+        run_reader(file fd, std::size_t block): fd_(std::move(fd)) {
+            ::lseek(fd_.get(), 0, SEEK_SET);
+            current_.reserve(block);
+            next_.reserve(block);
+            prefetch(fill(fd_.get(), current_));
+        }
+
+        run_reader(run_reader const&) = delete;
+        auto operator=(run_reader const&) -> run_reader& = delete;
+
+        ~run_reader() {
+            if (pending_.valid()) {
+                pending_.wait();
+            }
+        }
+
+        /** Returns true once every record has been read */
+        auto empty() const -> bool { return current_.empty(); }
+
+        /** Drops the first record, switching to the other buffer when this one is used up */
+        auto advance() -> void {
+            current_.pop_front();
+            if (current_.empty() && pending_.valid()) {
+                bool more = pending_.get();
+                current_.swap(next_);
+                prefetch(more);
+            }
+        }
+
+        auto begin() -> iterator { return iterator{*this}; }
+
+        auto end() const -> std::default_sentinel_t { return std::default_sentinel; }
+    };
+
+    /** Writes records to a file through two buffers. While one is filled the other is written on another thread. */
+    class run_writer {
+        int               fd_;
+        std::size_t       block_;
+        buffer_t          current_;
+        buffer_t          writing_;
+        std::future<void> pending_;
+
+        auto flush() -> void {
+            if (pending_.valid()) {
+                pending_.get();
+            }
+            current_.swap(writing_);
+            pending_ = std::async(std::launch::async, [this] { drain(fd_, writing_); });
+        }
+
+     public:
+        run_writer(int fd, std::size_t block): fd_(fd), block_(block) {
+            current_.reserve(block);
+            writing_.reserve(block);
+        }
+
+        run_writer(run_writer const&) = delete;
+        auto operator=(run_writer const&) -> run_writer& = delete;
+
+        ~run_writer() {
+            if (pending_.valid()) {
+                pending_.wait();
+            }
+        }
+
+        auto push(T const& record) -> void {
+            current_.push_back(record);
+            if (current_.size() == block_) {
+                flush();
+            }
+        }
+
+        /** Writes every buffered record, waiting until they are written */
+        auto finish() -> void {
+            if (!current_.empty()) {
+                flush();
+            }
+            if (pending_.valid()) {
+                pending_.get();
+            }
+        }
+    };
+
+    /** Splits the input into sorted run files, sorting on every worker thread while the main thread reads */
+    auto make_runs(int input, external_sort_stats& stats) -> std::vector<file> {
+        unsigned    workers = options_.threads != 0 ? options_.threads : std::max(1u, std::thread::hardware_concurrency());
+        std::size_t block   = records_in(options_.memory_budget / (workers + 1));
+
+        auto empty    = safe_queue<buffer_t>{};
+        auto filled   = safe_queue<buffer_t>{};
+        auto runs     = std::vector<file>{};
+        auto runs_mtx = std::mutex{};
+        auto failure  = std::exception_ptr{};
+
+        for (unsigned b=0; b < workers + 1; b++) {
+            auto buf = buffer_t{};
+            buf.reserve(block);
+            empty.put(std::move(buf));
+        }
+
+        auto sort_runs = [&] {
+            // An empty buffer tells the worker to stop
+            for (auto buf = filled.get(); !buf.empty(); buf = filled.get()) {
+                try {
+                    buf.sort(comp_);
+                    int fd;
+                    {
+                        auto lock = std::lock_guard{runs_mtx};
+                        fd = runs.emplace_back(make_temp()).get();
+                    }
+                    drain(fd, buf);
+                } catch (...) {
+                    auto lock = std::lock_guard{runs_mtx};
+                    failure = std::current_exception();
+                    buf.clear();
+                }
+                empty.put(std::move(buf));
+            }
+        };
+
+        {
+            auto threads = std::vector<std::jthread>{};
+            for (unsigned w=0; w < workers; w++) {
+                threads.emplace_back(sort_runs);
+            }
+
+            auto read_failure = std::exception_ptr{};
+            try {
+                for (bool more = true; more;) {
+                    auto buf = empty.get();
+                    {
+                        // A worker failed, so the rest of the input would only be read to be thrown away
+                        auto lock = std::lock_guard{runs_mtx};
+                        if (failure) {
+                            break;
+                        }
+                    }
+                    more     = fill(input, buf);
+                    stats.records += buf.size();
+                    if (!buf.empty()) {
+                        filled.put(std::move(buf));
+                    } else {
+                        empty.put(std::move(buf));
+                    }
+                }
+            } catch (...) {
+                read_failure = std::current_exception();
+            }
+            for (unsigned w=0; w < workers; w++) {
+                filled.put(buffer_t{});
+            }
+            threads.clear();
+
+            if (read_failure || failure) {
+                std::rethrow_exception(read_failure ? read_failure : failure);
+            }
+        }
+        return runs;
+    }
+
+    /** Returns the number of runs one merge can read, giving each two buffers of at least min_block_bytes and
+     *  keeping two for the output */
+    auto max_fan_in() const -> std::size_t {
+        return std::max<std::size_t>(options_.memory_budget / (2 * options_.min_block_bytes), 3) - 1;
+    }
+
+    /** Merges runs, closing them, into output */
+    auto merge(std::vector<file> runs, int output) -> void {
+        std::size_t block   = records_in(options_.memory_budget / (2 * runs.size() + 2));
+        auto        readers = std::deque<run_reader>{};
+        for (auto& fd: runs) {
+            readers.emplace_back(std::move(fd), block);
+        }
+
+        auto writer = run_writer{output, block};
+        for (auto const& record: kway_merge{readers, comp_}) {
+            writer.push(record);
+        }
+        writer.finish();
+    }
+
+ public:
+    explicit external_sorter(external_sort_options options = {}, Compare comp = Compare()): options_(std::move(options)),
+                                                                                           comp_(std::move(comp)) {}
+
+    /** Sorts the records of input into output, which is created or truncated. Throws std::system_error when a file
+     *  cannot be read or written, and std::runtime_error when the size of input is not a multiple of sizeof(T). */
+    auto sort(std::filesystem::path const& input, std::filesystem::path const& output) -> external_sort_stats {
+        auto stats = external_sort_stats{};
+        auto start = clock::now();
+
+        auto runs = make_runs(open_file(input, O_RDONLY).get(), stats);
+        stats.bytes       = stats.records * sizeof(T);
+        stats.runs        = runs.size();
+        stats.run_seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+        start    = clock::now();
+        auto out = open_file(output, O_WRONLY | O_CREAT | O_TRUNC);
+        std::size_t fan_in = max_fan_in();
+        while (runs.size() > fan_in) {
+            // Merge only as many of the oldest, shortest runs as leaves fan_in for the last merge, so as little
+            // data as possible is written twice. The longer run goes to the back for a later merge to pick up.
+            auto count = std::min(fan_in, runs.size() - fan_in + 1);
+            auto group = std::vector<file>(std::make_move_iterator(runs.begin()),
+                                           std::make_move_iterator(runs.begin() + count));
+            runs.erase(runs.begin(), runs.begin() + count);
+            int merged = runs.emplace_back(make_temp()).get();
+            merge(std::move(group), merged);
+            stats.merges++;
+        }
+        merge(std::move(runs), out.get());
+        stats.merges++;
+        if (out.close() != 0) {
+            fail("cannot close " + output.string());
+        }
+        stats.merge_seconds = std::chrono::duration<double>(clock::now() - start).count();
+        return stats;
+    }
+};
+
+/** Sorts the fixed size records of input into output with at most options.memory_budget bytes of buffers, returning
+ *  how long each phase took. See external_sorter. */
+template<typename T, typename Compare = std::less<>>
+requires std::is_trivially_copyable_v<T>
+auto external_sort(std::filesystem::path const& input,
+                   std::filesystem::path const& output,
+                   external_sort_options const& options = {},
+                   Compare comp = Compare()) -> external_sort_stats {
+    return external_sorter<T, Compare>{options, std::move(comp)}.sort(input, output);
+}
+
+}  // namespace dsc
@@ -2,11 +2,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iterator>
 #include <memory>
-#include <tuple>
+#include <memory_resource>
+#include <ranges>
 #include <type_traits>
+#include <utility>
 #include <compare>
 #include <print>
 
@@ -15,10 +22,55 @@ namespace dsc {
 struct min_heap {};
 struct max_heap {};
 
-template <typename T, typename HeapType, typename Allocator = std::allocator<T>>
-requires std::three_way_comparable<T> &&
-         std::disjunction_v<std::is_same<HeapType, min_heap>,
-                            std::is_same<HeapType, max_heap>>
+/** Heap order given by a comparator and a projection. a is nearer the top than b when comp(proj(a), proj(b)) holds,
+ *  so std::less<> gives a min heap and std::greater<> a max heap. Either can be a stateful object, passed to the heap's
+ *  constructor. */
+template<typename Compare = std::less<>, typename Proj = std::identity>
+struct heap_order {
+    [[no_unique_address]] Compare comp{};
+    [[no_unique_address]] Proj    proj{};
+
+    auto operator()(auto const& a, auto const& b) const -> bool {
+        return std::invoke(comp, std::invoke(proj, a), std::invoke(proj, b));
+    }
+};
+
+/** Projection onto a member known at compile time, so it needs no state */
+template<auto Member>
+struct member_projection {
+    template<typename U>
+    auto operator()(U const& value) const -> decltype(auto) { return std::invoke(Member, value); }
+};
+
+/** Heap order by one member or member function of the element, such as order_by<&task::deadline> */
+template<auto Member, typename Compare = std::less<>>
+using order_by = heap_order<Compare, member_projection<Member>>;
+
+/** Maps the HeapType of a heap to the heap_order it uses */
+template<typename HeapType>
+struct heap_order_of { using type = HeapType; };
+
+template<>
+struct heap_order_of<min_heap> { using type = heap_order<std::less<>>; };
+
+template<>
+struct heap_order_of<max_heap> { using type = heap_order<std::greater<>>; };
+
+/** HeapType is min_heap, max_heap, or an order which can compare two elements of T */
+template<typename HeapType, typename T>
+concept heap_ordering = std::copy_constructible<typename heap_order_of<HeapType>::type> &&
+    requires (typename heap_order_of<HeapType>::type const& order, T const& a, T const& b) {
+        { order(a, b) } -> std::convertible_to<bool>;
+    };
+
+/** Array-backed heap in which every node has Arity children. Wider heaps are shallower, and when Arity elements of T
+ *  fit in a cache line the array is offset so the children of each node share one line, making each level of a pop a
+ *  single cache miss. For arithmetic T the best child is picked with a reduction the compiler vectorizes.
+ *
+ *  HeapType is min_heap, max_heap or a heap_order, such as order_by<&task::deadline>, to order elements by a
+ *  comparator and projection. */
+template <typename T, typename HeapType, typename Allocator = std::allocator<T>, std::size_t Arity = 2>
+requires heap_ordering<HeapType, T> && (Arity >= 2)
 class heap {
 public:
 
@@ -30,39 +82,173 @@ public:
     using const_reference   = const value_type&;
     using pointer           = value_type*;
     using const_pointer     = const value_type*;
+    using order_type        = typename heap_order_of<HeapType>::type;
 
-private:
+protected:
+    /* Storage, growth and ordering are shared with minmax_heap, which derives from heap */
     using idx_t = size_type;
     using allc_tr = std::allocator_traits<Allocator>;
 
+    /* Children of a node are aligned to their combined size when it is a power of 2 no larger than a cache line */
+    static constexpr idx_t group_bytes  = Arity * sizeof(T);
+    static constexpr bool  align_groups = std::has_single_bit(group_bytes) && group_bytes <= 64;
+    /* Extra elements allocated so the array can be shifted into alignment */
+    static constexpr idx_t padding      = align_groups ? Arity - 1 : 0;
+
+    T* buffer_;
     T* elems_;
     idx_t size_;
     idx_t capacity_;
     idx_t min_capacity_;
     Allocator alloc_;
+    [[no_unique_address]] order_type order_;
+
+    /* Determines higher priority element given the heap order */
+    auto is_better(T const& a, T const& b) const -> bool {
+        return order_(a, b);
+    }
+
+    auto parent(idx_t child) -> idx_t {
+        return (child-1) / Arity;
+    }
+
+    auto first_child(idx_t parent) -> idx_t {
+        return parent*Arity + 1;
+    }
+
+    /** Returns the index of the best of the children starting at first. */
+    auto best_child(idx_t first) const -> idx_t {
+        T const* group = elems_ + first;
+
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (first + Arity <= size_) {
+                // A value-only reduction over a fixed number of children vectorizes, where tracking the index as well
+                // does not. Find the position afterwards.
+                T best = group[0];
+                for (idx_t idx=1; idx < Arity; idx++) {
+                    best = is_better(group[idx], best) ? group[idx] : best;
+                }
+                // Scanned backwards with selects rather than an early return, so a random position costs no
+                // mispredicted branch
+                idx_t pos = 0;
+                for (idx_t idx=Arity; idx-- > 0;) {
+                    pos = group[idx] == best ? idx : pos;
+                }
+                return first + pos;
+            }
+        }
 
-    /* Determines higher priority element given the heap type */
-    auto is_better(T& a, T& b) const {
-        if constexpr(std::is_same_v<HeapType, min_heap>) {
-            return a < b;
+        idx_t count = std::min<idx_t>(Arity, size_ - first);
+        idx_t best  = 0;
+        for (idx_t idx=1; idx < count; idx++) {
+            if (is_better(group[idx], group[best])) {
+                best = idx;
+            }
+        }
+        return first + best;
+    }
+
+    /** Returns buffer shifted forward so that the children of every node start on a multiple of group_bytes, with
+     *  element 0 alone before the first group. The shift is less than Arity elements, which padding covers. */
+    static auto align_children(T* buffer) -> T* {
+        if constexpr (align_groups) {
+            auto addr = reinterpret_cast<std::uintptr_t>(buffer + 1);
+            return buffer + (group_bytes - addr % group_bytes) % group_bytes / sizeof(T);
         } else {
-            return a > b;
+            return buffer;
         }
     }
 
-    auto parent(idx_t child) -> idx_t {
-        return (child-1) / 2;
+    /** Allocates an array for capacity elements plus the alignment padding, without touching the heap's own array **/
+    auto allocate_buffer(idx_t capacity) -> T* {
+        return allc_tr::allocate(alloc_, capacity + padding);
     }
 
-    auto children(idx_t parent) -> std::tuple<idx_t, idx_t>{
-        return std::make_tuple<idx_t, idx_t>(parent*2 + 1, parent*2 + 2);
+    /** Allocates an array for capacity_ elements and points elems_ at its aligned start **/
+    auto allocate_array() -> void {
+        buffer_ = allocate_buffer(capacity_);
+        elems_  = align_children(buffer_);
+    }
+
+    /** Moves the element at idx up while it is better than its parent. Parents are moved down into a hole and the
+     *  element is placed once at the end, so each level costs one move instead of a swap's three. An element which
+     *  is already in place is not moved at all. **/
+    auto sift_up(idx_t current_idx) -> void {
+        if (current_idx == 0 || !is_better(elems_[current_idx], elems_[parent(current_idx)])) {
+            return;
+        }
+
+        T value = std::move(elems_[current_idx]);
+        do {
+            idx_t parent_idx = parent(current_idx);
+            elems_[current_idx] = std::move(elems_[parent_idx]);
+            current_idx = parent_idx;
+        } while (current_idx > 0 && is_better(value, elems_[parent(current_idx)]));
+        elems_[current_idx] = std::move(value);
+    }
+
+    /** Fills the hole at hole_idx with value, first moving the best child up into the hole for as long as it is
+     *  better than value. value must not be an element at an index below size_. **/
+    template<typename V>
+    auto place_down(idx_t hole_idx, V&& value) -> void {
+        for (idx_t child_idx = first_child(hole_idx); child_idx < size_; child_idx = first_child(hole_idx)) {
+            idx_t next_idx = best_child(child_idx);
+            if (!is_better(elems_[next_idx], value)) {
+                // No more better elements
+                break;
+            }
+            elems_[hole_idx] = std::move(elems_[next_idx]);
+            hole_idx = next_idx;
+        }
+        elems_[hole_idx] = std::forward<V>(value);
+    }
+
+    /** Moves the element at idx down while one of its children is better. An element which is already in place is not
+     *  moved at all. **/
+    auto sift_down(idx_t current_idx) -> void {
+        idx_t child_idx = first_child(current_idx);
+        if (child_idx >= size_) {
+            return;
+        }
+        idx_t next_idx = best_child(child_idx);
+        if (!is_better(elems_[next_idx], elems_[current_idx])) {
+            return;
+        }
+
+        T value = std::move(elems_[current_idx]);
+        elems_[current_idx] = std::move(elems_[next_idx]);
+        place_down(next_idx, std::move(value));
+    }
+
+    /** Removes the top element, whose value must already have been moved out. The last element fills the hole. **/
+    auto remove_top() -> void {
+        size_--;
+        if (size_ > 0) {
+            // The last element now sits just past the end, out of reach of the sift
+            place_down(0, std::move(elems_[size_]));
+        }
+        allc_tr::destroy(alloc_, elems_+size_);
+    }
+
+    /** Floyd's bottom up construction: sifts down every node with children, from the last one to the root. Most nodes
+     *  are near the bottom and move only a level or two, so this takes O(n) rather than O(n log n). **/
+    auto heapify() -> void {
+        if (size_ < 2) {
+            return;
+        }
+        for (idx_t idx = parent(size_-1) + 1; idx-- > 0;) {
+            sift_down(idx);
+        }
     }
 
     static auto mem_size(idx_t count) { return sizeof(T)*count; }
 
     static auto move_array(Allocator& src_alloc, T* src, T* dest, idx_t count) -> void {
         if constexpr(std::is_trivially_copyable_v<T>) {
-            std::memcpy(dest, src, mem_size(count));
+            // memcpy requires valid pointers even for 0 bytes, and an empty moved from heap has none
+            if (count != 0) {
+                std::memcpy(dest, src, mem_size(count));
+            }
         } else {
             for (idx_t idx=0; idx < count; idx++) {
                 allc_tr::construct(src_alloc, dest+idx, std::move(src[idx]));
@@ -70,9 +256,19 @@ private:
         }
     }
 
+    static auto destroy_array(Allocator& src_alloc, T* src, idx_t count) -> void {
+        if constexpr(!std::is_trivially_destructible_v<T>) {
+            for (idx_t idx=0; idx < count; idx++) {
+                allc_tr::destroy(src_alloc, src+idx);
+            }
+        }
+    }
+
     static auto copy_array(Allocator& src_alloc, T* src, T* dest, idx_t count) -> void {
         if constexpr(std::is_trivially_copyable_v<T>) {
-            std::memcpy(dest, src, mem_size(count));
+            if (count != 0) {
+                std::memcpy(dest, src, mem_size(count));
+            }
         } else {
             for (idx_t idx=0; idx < count; idx++) {
                 allc_tr::construct(src_alloc, dest+idx, src[idx]);
@@ -88,44 +284,195 @@ private:
             return;
         }
 
-        auto old_capacity = capacity_;
+        // Nothing is committed until the new array exists, so a failed allocation leaves the heap unchanged
+        T* new_buffer = allocate_buffer(new_capacity);
+        T* new_elems  = align_children(new_buffer);
+
+        // A moved from heap has no array until its first push
+        if (buffer_) {
+            move_array(alloc_, elems_, new_elems, size_);
+            destroy_array(alloc_, elems_, size_);
+            allc_tr::deallocate(alloc_, buffer_, capacity_ + padding);
+        }
+        buffer_   = new_buffer;
+        elems_    = new_elems;
         capacity_ = new_capacity;
-        T* new_array = allc_tr::allocate(alloc_, capacity_);
+    }
+
+    /** Doubles the capacity when there is no room for one more element **/
+    auto grow_if_full() -> void {
+        if (capacity_ <= size_) {
+            resize(std::max<idx_t>(capacity_*2, 1));
+        }
+    }
 
-        move_array(alloc_, elems_, new_array, size_);
+    /** Takes over other's array and sizes, leaving other empty and without an array **/
+    auto steal(heap& other) -> void {
+        buffer_       = std::exchange(other.buffer_, nullptr);
+        elems_        = std::exchange(other.elems_, nullptr);
+        size_         = std::exchange(other.size_, 0);
+        capacity_     = std::exchange(other.capacity_, 0);
+        min_capacity_ = other.min_capacity_;
+    }
 
-        allc_tr::deallocate(alloc_, elems_, old_capacity);
+    /** Destroys all elements and returns the array to the allocator **/
+    auto release() -> void {
+        clear();
+        if (buffer_) {
+            allc_tr::deallocate(alloc_, buffer_, capacity_ + padding);
+        }
+        buffer_   = nullptr;
+        elems_    = nullptr;
+        capacity_ = 0;
+    }
 
-        elems_ = new_array;
+    /** Replaces the elements with copies of other's, or moves if other is an rvalue. The current array is reused when
+     *  it can hold other's elements, so assigning between heaps of similar size does not allocate. **/
+    template<typename Other>
+    auto assign_from(Other&& other) -> void {
+        clear();
+        if (capacity_ < other.size_) {
+            // Allocated before the old array is released, so a failed allocation leaves this heap empty but usable
+            T* new_buffer = allocate_buffer(other.capacity_);
+            release();
+            buffer_   = new_buffer;
+            elems_    = align_children(new_buffer);
+            capacity_ = other.capacity_;
+        }
+        if constexpr (std::is_rvalue_reference_v<Other&&>) {
+            move_array(alloc_, other.elems_, elems_, other.size_);
+        } else {
+            copy_array(alloc_, other.elems_, elems_, other.size_);
+        }
+        size_ = other.size_;
     }
 
 public:
-    /** Construct an empty heap with a minimum memory capacity **/
-    heap(idx_t min_capacity = 16): size_(0),
-                                   capacity_(min_capacity),
-                                   min_capacity_(min_capacity) {
-        elems_ = allc_tr::allocate(alloc_, capacity_);
+    /** Construct an empty heap with a minimum memory capacity, allocating through alloc **/
+    heap(idx_t min_capacity = 16, Allocator const& alloc = Allocator()): heap(order_type{}, min_capacity, alloc) {}
+
+    /** Construct an empty heap ordered by order, for comparators or projections which carry state **/
+    explicit heap(order_type order, idx_t min_capacity = 16, Allocator const& alloc = Allocator()):
+            size_(0),
+            capacity_(min_capacity),
+            min_capacity_(min_capacity),
+            alloc_(alloc),
+            order_(std::move(order)) {
+        allocate_array();
+    }
+
+    /** Construct an empty heap which allocates through alloc **/
+    explicit heap(Allocator const& alloc): heap(16, alloc) {}
+
+    /** Construct a heap holding every element of range, built bottom up in O(n) **/
+    template<std::ranges::input_range R>
+    requires (!std::same_as<std::remove_cvref_t<R>, heap>) &&
+             std::constructible_from<T, std::ranges::range_reference_t<R>>
+    explicit heap(R&& range, Allocator const& alloc = Allocator()): heap(16, alloc) {
+        push_range(std::forward<R>(range));
+    }
+
+    /** Construct a heap ordered by order holding every element of range, built bottom up in O(n) **/
+    template<std::ranges::input_range R>
+    requires (!std::same_as<std::remove_cvref_t<R>, heap>) &&
+             std::constructible_from<T, std::ranges::range_reference_t<R>>
+    heap(R&& range, order_type order, Allocator const& alloc = Allocator()): heap(std::move(order), 16, alloc) {
+        push_range(std::forward<R>(range));
     }
 
-    heap(heap<T, HeapType>& other): size_(other.size_),
-                                    capacity_(other.capacity_),
-                                    min_capacity_(other.min_capacity_) {
-        elems_ = allc_tr::allocate(alloc_, capacity_);
+    /** Copies other, with the allocator chosen by select_on_container_copy_construction **/
+    heap(heap const& other): heap(other, allc_tr::select_on_container_copy_construction(other.alloc_)) {}
+
+    /** Copies other, allocating through alloc **/
+    heap(heap const& other, Allocator const& alloc): size_(other.size_),
+                                                     capacity_(other.capacity_),
+                                                     min_capacity_(other.min_capacity_),
+                                                     alloc_(alloc),
+                                                     order_(other.order_) {
+        allocate_array();
         copy_array(alloc_, other.elems_, elems_, size_);
     }
 
-    heap(heap<T, HeapType>&& other): size_(other.size_),
-                                     capacity_(other.capacity_),
-                                     min_capacity_(other.min_capacity_) {
-        elems_ = allc_tr::allocate(alloc_, capacity_);
-        move_array(alloc_, other.elems_, elems_, size_);
-        other.size_ = 0;
+    /** Takes over other's array and allocator in O(1) without allocating. other is left empty and allocates again on
+     *  its next push. **/
+    heap(heap&& other) noexcept: min_capacity_(other.min_capacity_),
+                                 alloc_(std::move(other.alloc_)),
+                                 order_(other.order_) {
+        steal(other);
+    }
+
+    /** Takes over other's array if alloc compares equal to other's allocator, otherwise moves each element into a new
+     *  array from alloc **/
+    heap(heap&& other, Allocator const& alloc): min_capacity_(other.min_capacity_), alloc_(alloc), order_(other.order_) {
+        if (alloc_ == other.alloc_) {
+            steal(other);
+        } else {
+            size_     = other.size_;
+            capacity_ = other.capacity_;
+            allocate_array();
+            move_array(alloc_, other.elems_, elems_, size_);
+            other.clear();
+        }
     }
 
     virtual ~heap() {
-        allc_tr::deallocate(alloc_, elems_, capacity_);
+        release();
     }
 
+    /** Replaces the elements with copies of other's, reusing this heap's array when it is large enough. The allocator
+     *  is copied when it propagates on copy assignment. **/
+    auto operator=(heap const& other) -> heap& {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (allc_tr::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) {
+                release();
+            }
+            alloc_ = other.alloc_;
+        }
+        min_capacity_ = other.min_capacity_;
+        order_        = other.order_;
+        assign_from(other);
+
+        return *this;
+    }
+
+    /** Replaces the elements with other's, leaving other empty. other's array is taken over in O(1) when the allocator
+     *  propagates on move assignment or the allocators compare equal, otherwise each element is moved into this heap's
+     *  array. **/
+    auto operator=(heap&& other) noexcept(allc_tr::propagate_on_container_move_assignment::value ||
+                                          allc_tr::is_always_equal::value) -> heap& {
+        if (this == &other) {
+            return *this;
+        }
+
+        order_ = other.order_;
+        if constexpr (allc_tr::propagate_on_container_move_assignment::value) {
+            release();
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                release();
+                steal(other);
+            } else {
+                min_capacity_ = other.min_capacity_;
+                assign_from(std::move(other));
+                other.clear();
+            }
+        }
+
+        return *this;
+    }
+
+    /** Returns a copy of the allocator **/
+    auto get_allocator() const -> allocator_type { return alloc_; }
+
+    /** Returns the order used to compare elements **/
+    auto order() const -> order_type const& { return order_; }
+
 
     /* ========================================================== */
     /* ====================  ELEMENT ACCESS  ==================== */
@@ -167,7 +514,7 @@ public:
         using reference         = value_type&;
         using iterator_category = std::bidirectional_iterator_tag;
 
-        iterator(heap<T, HeapType>& heap, idx_t idx = 0) : data_(heap.data()), idx_(idx) {}
+        iterator(heap& heap, idx_t idx = 0) : data_(heap.data()), idx_(idx) {}
 
         auto operator++()    -> iterator& { idx_++; return *this; }
         auto operator++(int) -> iterator  { iterator retval = *this; ++(*this); return retval; }
@@ -185,22 +532,22 @@ public:
 
     class const_iterator {
      private:
-        const T* const data_;
+        const T* data_;
         idx_t idx_;
 
      public:
         using difference_type   = std::ptrdiff_t;
         using value_type        = T;
-        using pointer           = const value_type * const;
+        using pointer           = const value_type*;
         using reference         = const value_type&;
         using iterator_category = std::bidirectional_iterator_tag;
 
-        const_iterator(const heap<T, HeapType>& heap, idx_t idx = 0) : data_(heap.data()), idx_(idx) {}
+        const_iterator(const heap& heap, idx_t idx = 0) : data_(heap.data()), idx_(idx) {}
 
         auto operator++()    -> const_iterator& { idx_++; return *this; }
         auto operator++(int) -> const_iterator  { const_iterator retval = *this; ++(*this); return retval; }
 
-        auto operator<=>(iterator const& other) const = default;
+        auto operator<=>(const_iterator const& other) const = default;
 
         auto operator* () -> reference { return  data_[idx_]; }
         auto operator->() -> pointer   { return &data_[idx_]; }
@@ -269,67 +616,87 @@ public:
     /* ========================================================== */
     /* ========================  MODIFIERS  ===================== */
 
+    /** Removes and returns the top element **/
     auto pop() -> T {
-        auto popped = std::move(elems_[0]);
-        elems_[0] = std::move(elems_[size_-1]);
-        size_--;
+        T popped = std::move(elems_[0]);
+        remove_top();
+        return popped;
+    }
 
-        // Take the last element, move it to the front, and bubble it back to the bottom, pulling up the next best element
-        idx_t current_idx = 0;
-        while(true) {
-            auto [left_idx, right_idx] = children(current_idx);
-            reference current = elems_[current_idx];
-            if (right_idx >= size_) {
-                if (left_idx >= size_) {
-                    // no children, we're done.
-                    break;
-                } else {
-                    // Only a left child
-                    reference left = elems_[left_idx];
-                    if (is_better(left, current)) {
-                        std::swap(left, current);
-                        current_idx = left_idx;
-                    } else {
-                        // No more better elements
-                        break;
-                    }
-                }
-            } else {
-                // Has two children
-                reference left  = elems_[left_idx];
-                reference right = elems_[right_idx];
-                idx_t next_idx;
-                reference next  = is_better(left, right) ? (next_idx=left_idx, left)
-                                                                : (next_idx=right_idx, right);
-                if (is_better(next, current)) {
-                    std::swap(next, current);
-                    current_idx = next_idx;
-                } else {
-                    // No more better elements
-                    break;
-                }
-            }
+    /** Removes the top element, moving it straight into out. Saves a move over out = pop() for expensive to move T. **/
+    auto pop(T& out) -> void {
+        out = std::move(elems_[0]);
+        remove_top();
+    }
+
+    /** Replaces the top element with value using a single sift down, instead of a pop and a push. The heap must not be
+     *  empty. Read front() first if the old top is needed. **/
+    template<typename U = T>
+    requires std::assignable_from<T&, U&&>
+    auto replace_top(U&& value) -> void {
+        if constexpr (std::is_same_v<std::remove_cvref_t<U>, T>) {
+            place_down(0, std::forward<U>(value));
+        } else {
+            // Convert once, rather than at every comparison on the way down
+            place_down(0, T(std::forward<U>(value)));
         }
+    }
 
-        return popped;
+    /** Pushes value and then pops and returns the top element, with at most a single sift down. If value would be the
+     *  new top, it is returned straight away and the heap is not touched. **/
+    template<typename U = T>
+    requires std::constructible_from<T, U&&> && std::assignable_from<T&, U&&>
+    auto push_pop(U&& value) -> T {
+        if constexpr (!std::is_same_v<std::remove_cvref_t<U>, T>) {
+            // Convert once, rather than at every comparison on the way down
+            return push_pop(T(std::forward<U>(value)));
+        } else {
+            if (size_ == 0 || !is_better(elems_[0], value)) {
+                return T(std::forward<U>(value));
+            }
+
+            T popped = std::move(elems_[0]);
+            place_down(0, std::forward<U>(value));
+            return popped;
+        }
     }
 
     template <typename... Params>
     auto push(Params &&... params) -> void {
-        if (capacity_ <= size_) {
-            resize(capacity_*2);
-        }
+        grow_if_full();
 
         allc_tr::construct(alloc_, elems_+size_, std::forward<Params&&>(params)...);
+        size_++;
+        sift_up(size_-1);
+    }
 
-        for (idx_t current_idx = size_, parent_idx = parent(current_idx);
-             current_idx > 0 && is_better(elems_[current_idx], elems_[parent_idx]);
-             current_idx = parent(current_idx), parent_idx = parent(current_idx)) {
-            // bubble element to the top as long as it's better
-            std::swap(elems_[current_idx], elems_[parent_idx]);
+    /** Pushes every element of range. They are appended first, then ordered either by sifting each one up, or by
+     *  rebuilding the whole heap bottom up in O(n) when the batch is at least as large as the heap was. Sized ranges
+     *  reserve space once up front. **/
+    template<std::ranges::input_range R>
+    requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+    auto push_range(R&& range) -> void {
+        if constexpr (std::ranges::sized_range<R>) {
+            auto needed = size_ + static_cast<idx_t>(std::ranges::size(range));
+            if (needed > capacity_) {
+                resize(std::max<idx_t>(needed, capacity_*2));
+            }
         }
 
-        size_++;
+        idx_t old_size = size_;
+        for (auto&& value: range) {
+            grow_if_full();
+            allc_tr::construct(alloc_, elems_+size_, std::forward<decltype(value)>(value));
+            size_++;
+        }
+
+        if (size_ - old_size >= old_size) {
+            heapify();
+        } else {
+            for (idx_t idx=old_size; idx < size_; idx++) {
+                sift_up(idx);
+            }
+        }
     }
 
     /** Remove all elements from the vector. */
@@ -343,10 +710,122 @@ public:
         size_  = 0;
     }
 
+    /** Swaps the contents of two heaps in O(1). Allocators are swapped when they propagate on swap, otherwise they
+     *  must compare equal. **/
+    auto swap(heap& other) noexcept -> void {
+        if constexpr (allc_tr::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
+        std::swap(buffer_,       other.buffer_);
+        std::swap(elems_,        other.elems_);
+        std::swap(size_,         other.size_);
+        std::swap(capacity_,     other.capacity_);
+        std::swap(min_capacity_, other.min_capacity_);
+        std::swap(order_,        other.order_);
+    }
+
 
     /* ========================================================== */
     /* =======================  OPERATIONS  ===================== */
 
 };
 
-}
\ No newline at end of file
+/** Heap ordered by comp(proj(a), proj(b)) which computes each element's key once, when it is pushed, and stores it
+ *  next to the element. Sifts compare the stored keys, so a projection which is expensive, or which dereferences a
+ *  payload held by pointer, runs once per element instead of at every comparison. */
+template<typename T, typename Proj, typename Compare = std::less<>, typename Allocator = std::allocator<T>,
+         std::size_t Arity = 2>
+requires std::regular_invocable<Proj&, T const&>
+class cached_key_heap {
+ public:
+    using value_type     = T;
+    using key_type       = std::remove_cvref_t<std::invoke_result_t<Proj&, T const&>>;
+    using allocator_type = Allocator;
+    using size_type      = std::size_t;
+
+ private:
+    struct entry {
+        key_type key;
+        T        value;
+    };
+
+    /** Projects an entry onto its stored key */
+    struct entry_key {
+        auto operator()(entry const& e) const -> key_type const& { return e.key; }
+    };
+
+    using entry_alloc_t = typename std::allocator_traits<Allocator>::template rebind_alloc<entry>;
+    using heap_t        = heap<entry, heap_order<Compare, entry_key>, entry_alloc_t, Arity>;
+
+    heap_t                      heap_;
+    [[no_unique_address]] Proj  proj_;
+
+    auto make_entry(T&& value) -> entry {
+        auto key = std::invoke(proj_, std::as_const(value));
+        return entry{std::move(key), std::move(value)};
+    }
+
+ public:
+    /** Construct an empty heap with the given projection and comparator, allocating through alloc */
+    explicit cached_key_heap(Proj proj = {}, Compare comp = {}, Allocator const& alloc = Allocator()):
+        heap_(heap_order<Compare, entry_key>{std::move(comp), {}}, 16, entry_alloc_t(alloc)),
+        proj_(std::move(proj)) {}
+
+    /** Returns a copy of the allocator */
+    auto get_allocator() const -> allocator_type { return Allocator(heap_.get_allocator()); }
+
+    /** Returns the best element */
+    auto front() const -> T const& { return heap_.front().value; }
+
+    /** Returns the stored key of the best element */
+    auto front_key() const -> key_type const& { return heap_.front().key; }
+
+    /** Returns true if there are no elements */
+    auto empty() const -> bool { return heap_.empty(); }
+
+    /** Returns number of elements */
+    auto size() const -> size_type { return heap_.size(); }
+
+    /** Reserves space for count elements */
+    auto reserve(size_type count) -> void { heap_.reserve(count); }
+
+    /** Constructs an element from params, computing its key once */
+    template<typename... Params>
+    requires std::constructible_from<T, Params&&...>
+    auto push(Params&&... params) -> void {
+        heap_.push(make_entry(T(std::forward<Params>(params)...)));
+    }
+
+    /** Removes and returns the best element */
+    auto pop() -> T {
+        return std::move(heap_.pop().value);
+    }
+
+    /** Replaces the best element with value using a single sift down. The heap must not be empty. */
+    auto replace_top(T value) -> void {
+        heap_.replace_top(make_entry(std::move(value)));
+    }
+
+    /** Pushes value and then pops and returns the best element, with at most a single sift down */
+    auto push_pop(T value) -> T {
+        return std::move(heap_.push_pop(make_entry(std::move(value))).value);
+    }
+
+    /** Removes every element */
+    auto clear() -> void { heap_.clear(); }
+};
+
+
+namespace pmr {
+
+/** heap which allocates from a std::pmr::memory_resource */
+template<typename T, typename HeapType, std::size_t Arity = 2>
+using heap = dsc::heap<T, HeapType, std::pmr::polymorphic_allocator<T>, Arity>;
+
+/** cached_key_heap which allocates from a std::pmr::memory_resource */
+template<typename T, typename Proj, typename Compare = std::less<>, std::size_t Arity = 2>
+using cached_key_heap = dsc::cached_key_heap<T, Proj, Compare, std::pmr::polymorphic_allocator<T>, Arity>;
+
+}  // namespace pmr
+
+}  // namespace dsc
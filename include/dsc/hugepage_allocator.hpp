@@ -0,0 +1,103 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace dsc {
+
+/** Allocator which always returns 64 byte, cache line aligned memory, and backs allocations of at least HugeThreshold
+ *  bytes with 2 MB huge pages so that random access over large buffers takes far fewer TLB misses.
+ *
+ *  Large allocations first try explicit hugetlb pages, which only succeeds when the administrator has reserved them in
+ *  /proc/sys/vm/nr_hugepages. Otherwise they fall back to a normal mapping aligned to 2 MB and marked with
+ *  madvise(MADV_HUGEPAGE), which the kernel backs with transparent huge pages when it is enabled and can find them,
+ *  and with normal pages when it cannot. Smaller allocations use aligned operator new. Linux only.
+ *
+ *  Opt in by passing it as the Allocator of ring_vector or heap, or as hugepage_allocator<splay_tree_node<T>> for
+ *  splay_tree, which gives every node its own cache line. */
+template<typename T, std::size_t HugeThreshold = std::size_t{1} << 21>
+class hugepage_allocator {
+ public:
+    using value_type = T;
+
+    static constexpr std::size_t alignment      = 64;
+    static constexpr std::size_t huge_page_size = std::size_t{1} << 21;
+
+    static_assert(alignof(T) <= alignment, "hugepage_allocator cannot satisfy alignment of T");
+
+    template<typename U>
+    struct rebind {
+        using other = hugepage_allocator<U, HugeThreshold>;
+    };
+
+    hugepage_allocator() = default;
+
+    template<typename U>
+    hugepage_allocator(hugepage_allocator<U, HugeThreshold> const&) noexcept {}
+
+    /** Allocates space for n elements, on huge pages if it takes at least HugeThreshold bytes */
+    auto allocate(std::size_t n) -> T* {
+        auto bytes = n * sizeof(T);
+        if (bytes < HugeThreshold) {
+            return static_cast<T*>(::operator new(bytes, std::align_val_t{alignment}));
+        }
+
+        auto size = map_size(bytes);
+        void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (21 << MAP_HUGE_SHIFT), -1, 0);
+        if (mem != MAP_FAILED) {
+            return static_cast<T*>(mem);
+        }
+        return static_cast<T*>(map_transparent(size));
+    }
+
+    /** Releases memory previously returned by allocate with the same element count */
+    auto deallocate(T* array, std::size_t n) -> void {
+        if (!array) {
+            return;
+        }
+
+        auto bytes = n * sizeof(T);
+        if (bytes < HugeThreshold) {
+            ::operator delete(array, std::align_val_t{alignment});
+        } else {
+            munmap(array, map_size(bytes));
+        }
+    }
+
+    friend auto operator==(hugepage_allocator const&, hugepage_allocator const&) -> bool { return true; }
+
+ private:
+    static auto map_size(std::size_t bytes) -> std::size_t {
+        return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+    }
+
+    /** Maps size bytes at a 2 MB aligned address and asks for transparent huge pages. mmap only aligns to normal
+     *  pages, so one extra huge page is mapped and the unaligned ends are trimmed off. */
+    static auto map_transparent(std::size_t size) -> void* {
+        void* raw = mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc{};
+        }
+
+        auto start   = reinterpret_cast<std::uintptr_t>(raw);
+        auto aligned = (start + huge_page_size - 1) & ~(huge_page_size - 1);
+        if (aligned != start) {
+            munmap(raw, aligned - start);
+        }
+        if (auto tail = start + huge_page_size - aligned; tail != 0) {
+            munmap(reinterpret_cast<void*>(aligned + size), tail);
+        }
+
+        // Only a hint. Without transparent huge page support the mapping stays on normal pages.
+        madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);
+        return reinterpret_cast<void*>(aligned);
+    }
+};
+
+}  // namespace dsc
@@ -0,0 +1,431 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "dsc/index_iterator.hpp"
+
+namespace dsc {
+
+/** Ring vector which spreads the cost of growing over later operations. When the array is full a new array of twice
+ *  the capacity is allocated, but elements stay in the old array and at most MigrateStep of them are moved on each
+ *  following modification. Element access checks which array holds the element. This bounds the worst case latency
+ *  of push_back to one allocation plus MigrateStep moves, at the cost of a branch on every access while migrating.
+ *
+ *  Elements are addressed by an absolute sequence number which only changes with push_front/pop_front. Element a is
+ *  stored at array[a & mask] in both arrays, so migrating an element never changes where its neighbours live. */
+template<typename T, typename Allocator = std::allocator<T>, std::size_t MigrateStep = 2>
+class incremental_ring_vector {
+    static_assert(MigrateStep >= 2, "MigrateStep must be at least 2 to finish migrating before the next resize");
+
+    using ui32    = std::size_t;
+    using allc_tr = std::allocator_traits<Allocator>;
+
+    Allocator   alloc_;
+    ui32        begin_,
+                end_,
+                capacity_,
+                idx_mask_;
+    T*          array_;
+
+    // Array being migrated from. Absolute positions [old_begin_, old_end_) still live in it.
+    ui32        old_begin_,
+                old_end_,
+                old_capacity_,
+                old_idx_mask_;
+    T*          old_array_;
+
+    /** Returns true if the element at absolute position abs is still in the old array */
+    auto in_old(ui32 abs) const -> bool {
+        return (abs - old_begin_) < (old_end_ - old_begin_);
+    }
+
+    /** Returns the slot holding the element at absolute position abs */
+    auto slot(ui32 abs) const -> T* {
+        if (old_array_ && in_old(abs)) {
+            return old_array_ + (abs & old_idx_mask_);
+        }
+        return array_ + (abs & idx_mask_);
+    }
+
+    /** Moves up to count elements from the old array into the current array, freeing the old array once empty */
+    auto migrate(ui32 count) -> void {
+        if (!old_array_) {
+            return;
+        }
+
+        for (; count > 0 && old_begin_ != old_end_; count--, old_begin_++) {
+            T* src = old_array_ + (old_begin_ & old_idx_mask_);
+            allc_tr::construct(alloc_, array_ + (old_begin_ & idx_mask_), std::move(*src));
+            allc_tr::destroy(alloc_, src);
+        }
+
+        if (old_begin_ == old_end_) {
+            allc_tr::deallocate(alloc_, old_array_, old_capacity_);
+            old_array_ = nullptr;
+        }
+    }
+
+    /** Starts migrating into an array of double the capacity. Any unfinished migration is completed first. */
+    auto grow() -> void {
+        migrate(end_ - begin_);
+
+        // Allocate before touching any state, so a throwing allocation leaves the vector unchanged
+        ui32 new_capacity = std::max<ui32>(capacity_*2, 4);
+        T*   new_array    = allc_tr::allocate(alloc_, new_capacity);
+
+        old_array_    = array_;
+        old_capacity_ = capacity_;
+        old_idx_mask_ = idx_mask_;
+        old_begin_    = begin_;
+        old_end_      = end_;
+
+        capacity_  = new_capacity;
+        idx_mask_  = capacity_ - 1;
+        array_     = new_array;
+    }
+
+    /** Destroys all elements and deallocates both arrays, leaving the vector with no storage */
+    auto destroy() -> void {
+        clear();
+        if (array_) {
+            allc_tr::deallocate(alloc_, array_, capacity_);
+        }
+        capacity_ = 0;
+        idx_mask_ = 0;
+        array_    = nullptr;
+    }
+
+    /** Takes both arrays of other, leaving it empty with no storage. This vector must already be destroyed. */
+    auto steal(incremental_ring_vector& other) -> void {
+        begin_        = std::exchange(other.begin_, 0);
+        end_          = std::exchange(other.end_, 0);
+        capacity_     = std::exchange(other.capacity_, 0);
+        idx_mask_     = std::exchange(other.idx_mask_, 0);
+        array_        = std::exchange(other.array_, nullptr);
+        old_begin_    = std::exchange(other.old_begin_, 0);
+        old_end_      = std::exchange(other.old_end_, 0);
+        old_capacity_ = std::exchange(other.old_capacity_, 0);
+        old_idx_mask_ = std::exchange(other.old_idx_mask_, 0);
+        old_array_    = std::exchange(other.old_array_, nullptr);
+    }
+
+    /** Allocates a single array of at least other's capacity through this vector's allocator and copies each element
+     *  of other into it, or moves them if other is an rvalue. This vector must already be destroyed. */
+    template<typename Other>
+    auto construct_from(Other&& other) -> void {
+        ui32 new_capacity = 4;
+        while (new_capacity < other.capacity_) {
+            new_capacity *= 2;
+        }
+        array_    = allc_tr::allocate(alloc_, new_capacity);
+        capacity_ = new_capacity;
+        idx_mask_ = new_capacity - 1;
+
+        for (ui32 idx=0; idx < other.size(); idx++) {
+            if constexpr (std::is_rvalue_reference_v<Other&&>) {
+                push_back(std::move(other[idx]));
+            } else {
+                push_back(other[idx]);
+            }
+        }
+    }
+
+ public:
+    using value_type        = T;
+    using allocator_type    = Allocator;
+    using size_type         = ui32;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+    using pointer           = value_type*;
+    using const_pointer     = const value_type*;
+
+    /** Allocates an empty ring vector with reserve_space reserved, rounded up to a power of 2 with a minimum of 4. */
+    explicit incremental_ring_vector(ui32 reserve_space = 4, Allocator const& alloc = Allocator()):
+        alloc_(alloc),
+        begin_(0),
+        end_(0),
+        capacity_(4),
+        old_begin_(0),
+        old_end_(0),
+        old_capacity_(0),
+        old_idx_mask_(0),
+        old_array_(nullptr) {
+        while (capacity_ < reserve_space) {
+            capacity_ *= 2;
+        }
+        idx_mask_ = capacity_ - 1;
+        array_    = allc_tr::allocate(alloc_, capacity_);
+    }
+
+    /** Allocates an empty ring vector which allocates all of its memory through alloc */
+    explicit incremental_ring_vector(Allocator const& alloc): incremental_ring_vector(4, alloc) {}
+
+    /** Copy constructor which copies all elements into a single array of the same capacity. The allocator is chosen
+     *  by select_on_container_copy_construction. */
+    incremental_ring_vector(incremental_ring_vector const& other):
+        incremental_ring_vector(other, allc_tr::select_on_container_copy_construction(other.alloc_)) {}
+
+    /** Copy constructor which allocates through alloc */
+    incremental_ring_vector(incremental_ring_vector const& other, Allocator const& alloc):
+        incremental_ring_vector(other.capacity_, alloc) {
+        for (ui32 idx=0; idx < other.size(); idx++) {
+            push_back(other[idx]);
+        }
+    }
+
+    /** Move constructor which takes both arrays and the allocator of the other vector and leaves it empty without
+     *  storage */
+    incremental_ring_vector(incremental_ring_vector&& other) noexcept: alloc_(std::move(other.alloc_)) {
+        steal(other);
+    }
+
+    /** Move constructor which allocates through alloc. Takes other's arrays if alloc compares equal to other's
+     *  allocator, otherwise moves each element into a single new array. */
+    incremental_ring_vector(incremental_ring_vector&& other, Allocator const& alloc):
+        alloc_(alloc),
+        begin_(0),
+        end_(0),
+        old_begin_(0),
+        old_end_(0),
+        old_capacity_(0),
+        old_idx_mask_(0),
+        old_array_(nullptr) {
+        if (alloc_ == other.alloc_) {
+            steal(other);
+        } else {
+            construct_from(std::move(other));
+        }
+    }
+
+    ~incremental_ring_vector() {
+        destroy();
+    }
+
+    /** Replaces the contents with a copy of other. The allocator is replaced by other's only if
+     *  propagate_on_container_copy_assignment is set. */
+    auto operator=(incremental_ring_vector const& other) -> incremental_ring_vector& {
+        if (this == &other) {
+            return *this;
+        }
+
+        destroy();
+        if constexpr (allc_tr::propagate_on_container_copy_assignment::value) {
+            alloc_ = other.alloc_;
+        }
+        construct_from(other);
+
+        return *this;
+    }
+
+    /** Replaces the contents with those of other, leaving other empty. other's arrays are taken over when the
+     *  allocator propagates on move assignment or the allocators compare equal, otherwise each element is moved into
+     *  a new array from this vector's allocator. */
+    auto operator=(incremental_ring_vector&& other) -> incremental_ring_vector& {
+        if (this == &other) {
+            return *this;
+        }
+
+        destroy();
+        if constexpr (allc_tr::propagate_on_container_move_assignment::value) {
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                steal(other);
+            } else {
+                construct_from(std::move(other));
+                other.clear();
+            }
+        }
+
+        return *this;
+    }
+
+    /** Swaps contents with other. Allocators are swapped only if propagate_on_container_swap is set, otherwise
+     *  they must compare equal. */
+    auto swap(incremental_ring_vector& other) -> void {
+        if constexpr (allc_tr::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
+        std::swap(begin_,        other.begin_);
+        std::swap(end_,          other.end_);
+        std::swap(capacity_,     other.capacity_);
+        std::swap(idx_mask_,     other.idx_mask_);
+        std::swap(array_,        other.array_);
+        std::swap(old_begin_,    other.old_begin_);
+        std::swap(old_end_,      other.old_end_);
+        std::swap(old_capacity_, other.old_capacity_);
+        std::swap(old_idx_mask_, other.old_idx_mask_);
+        std::swap(old_array_,    other.old_array_);
+    }
+
+    /** Returns a copy of the allocator */
+    auto get_allocator() const -> allocator_type { return alloc_; }
+
+
+    /* ========================================================== */
+    /* ====================  ELEMENT ACCESS  ==================== */
+
+    /** Returns reference to an element at the given position */
+    auto at(ui32 pos)       -> reference       { return *slot(begin_ + pos); }
+    /** Returns const reference to an element at the given position */
+    auto at(ui32 pos) const -> const_reference { return *slot(begin_ + pos); }
+
+    /** Returns reference to an element at the given position */
+    auto operator[](ui32 pos)       -> reference       { return *slot(begin_ + pos); }
+    /** Returns const reference to an element at the given position */
+    auto operator[](ui32 pos) const -> const_reference { return *slot(begin_ + pos); }
+
+    /** Returns reference to first element in vector */
+    auto front()       -> reference       { return *slot(begin_); }
+    /** Returns const reference to first element in vector */
+    auto front() const -> const_reference { return *slot(begin_); }
+
+    /** Returns reference to last element in vector */
+    auto back()       -> reference       { return *slot(end_ - 1); }
+    /** Returns const reference to last element in vector */
+    auto back() const -> const_reference { return *slot(end_ - 1); }
+
+
+    /* ========================================================== */
+    /* =======================  ITERATORS  ====================== */
+
+    using iterator       = index_iterator<incremental_ring_vector, T>;
+    using const_iterator = index_iterator<incremental_ring_vector, T const>;
+
+    /** Returns random access iterator on this vector starting at front */
+    auto begin() -> iterator { return {*this, 0}; }
+    /** Returns end position of random access iterator */
+    auto end()   -> iterator { return {*this, size()}; }
+
+    /** Returns const random access iterator on this vector starting at front */
+    auto begin() const -> const_iterator { return {*this, 0}; }
+    /** Returns end position of const random access iterator */
+    auto end()   const -> const_iterator { return {*this, size()}; }
+
+    /** Returns const random access iterator on this vector starting at front */
+    auto cbegin() const -> const_iterator { return {*this, 0}; }
+    /** Returns end position of const random access iterator */
+    auto cend()   const -> const_iterator { return {*this, size()}; }
+
+
+    /* ========================================================== */
+    /* ========================  CAPACITY  ====================== */
+
+    /** Returns true if size of vector is 0 */
+    auto empty()    const -> bool { return begin_ == end_; }
+
+    /** Returns number of elements being used in array */
+    auto size()     const -> ui32 { return end_ - begin_; }
+
+    /** Returns number of reserved array elements */
+    auto capacity() const -> ui32 { return capacity_; }
+
+    /** Returns true if elements are still being moved out of a previous array */
+    auto migrating() const -> bool { return old_array_ != nullptr; }
+
+
+    /* ========================================================== */
+    /* ========================  MODIFIERS  ===================== */
+
+    /** Remove all elements from the vector and release the old array if still migrating. */
+    auto clear() -> void {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (ui32 abs=begin_; abs != end_; abs++) {
+                allc_tr::destroy(alloc_, slot(abs));
+            }
+        }
+        if (old_array_) {
+            allc_tr::deallocate(alloc_, old_array_, old_capacity_);
+            old_array_ = nullptr;
+        }
+        begin_     = 0;
+        end_       = 0;
+        old_begin_ = 0;
+        old_end_   = 0;
+    }
+
+    /** Place one element at the end of the vector. Starts a new migration if capacity is reached. */
+    auto push_back(T value) -> void {
+        emplace_back(std::move(value));
+    }
+
+    template<typename... Args>
+    auto emplace_back(Args&&... args) -> void {
+        if (size() >= capacity_) {
+            grow();
+        }
+        migrate(MigrateStep);
+
+        allc_tr::construct(alloc_, array_ + (end_ & idx_mask_), std::forward<Args>(args)...);
+        end_++;
+    }
+
+    /** Place one element at the beginning of the vector. Starts a new migration if capacity is reached. */
+    auto push_front(T value) -> void {
+        emplace_front(std::move(value));
+    }
+
+    template<typename... Args>
+    auto emplace_front(Args&&... args) -> void {
+        if (size() >= capacity_) {
+            grow();
+        }
+        migrate(MigrateStep);
+
+        allc_tr::construct(alloc_, array_ + ((begin_ - 1) & idx_mask_), std::forward<Args>(args)...);
+        begin_--;
+    }
+
+    /** Remove one element from the end of the vector */
+    auto pop_back() -> void {
+        allc_tr::destroy(alloc_, slot(end_ - 1));
+        if (old_array_ && in_old(end_ - 1)) {
+            old_end_--;
+        }
+        end_--;
+        migrate(MigrateStep);
+    }
+
+    /** Remove one element from the end of the vector and return the element */
+    auto pop_back_get() -> T {
+        T temp = std::move(back());
+        pop_back();
+        return temp;
+    }
+
+    /** Remove one element from the beginning of the vector */
+    auto pop_front() -> void {
+        allc_tr::destroy(alloc_, slot(begin_));
+        if (old_array_ && in_old(begin_)) {
+            old_begin_++;
+        }
+        begin_++;
+        migrate(MigrateStep);
+    }
+
+    /** Remove one element from the beginning of the vector and return the element */
+    auto pop_front_get() -> T {
+        T temp = std::move(front());
+        pop_front();
+        return temp;
+    }
+};
+
+namespace pmr {
+
+/** incremental_ring_vector which allocates from a std::pmr::memory_resource */
+template<typename T, std::size_t MigrateStep = 2>
+using incremental_ring_vector = dsc::incremental_ring_vector<T, std::pmr::polymorphic_allocator<T>, MigrateStep>;
+
+}  // namespace pmr
+
+}  // namespace dsc
@@ -0,0 +1,72 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace dsc {
+
+/** Random access iterator over any container with operator[](std::size_t), shared by the ring buffers. It holds a
+ *  pointer to the container and a logical position, so it stays valid across growth but is shifted by any operation
+ *  which moves elements, such as push_front or insert. V is either the container's value type or the value type
+ *  const, and only the const version can be formed from a const container. */
+template<typename Container, typename V>
+class index_iterator {
+ private:
+    using container_ref = std::conditional_t<std::is_const_v<V>, Container const&, Container&>;
+    using container_ptr = std::conditional_t<std::is_const_v<V>, Container const*, Container*>;
+
+    template<typename, typename> friend class index_iterator;
+
+    container_ptr   m_container;
+    std::ptrdiff_t  m_idx;
+
+ public:
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = std::remove_const_t<V>;
+    using pointer           = V*;
+    using reference         = V&;
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept  = std::random_access_iterator_tag;
+
+    constexpr index_iterator(): m_container(nullptr), m_idx(0) {}
+    constexpr index_iterator(container_ref container, std::size_t idx = 0): m_container(&container),
+                                                                           m_idx(static_cast<difference_type>(idx)) {}
+
+    /** Converts an iterator into a const_iterator */
+    template<typename U>
+    requires (std::is_const_v<V> && std::is_same_v<U const, V>)
+    constexpr index_iterator(index_iterator<Container, U> const& other): m_container(other.m_container),
+                                                                         m_idx(other.m_idx) {}
+
+    /** Returns the position this iterator refers to */
+    constexpr auto index() const -> std::size_t { return static_cast<std::size_t>(m_idx); }
+
+    constexpr auto operator++()    -> index_iterator& { m_idx++; return *this; }
+    constexpr auto operator++(int) -> index_iterator  { index_iterator retval = *this; ++(*this); return retval; }
+    constexpr auto operator--()    -> index_iterator& { m_idx--; return *this; }
+    constexpr auto operator--(int) -> index_iterator  { index_iterator retval = *this; --(*this); return retval; }
+
+    constexpr auto operator+=(difference_type offset) -> index_iterator& { m_idx += offset; return *this; }
+    constexpr auto operator-=(difference_type offset) -> index_iterator& { m_idx -= offset; return *this; }
+
+    constexpr auto operator+(difference_type offset) const -> index_iterator { index_iterator retval = *this; return retval += offset; }
+    constexpr auto operator-(difference_type offset) const -> index_iterator { index_iterator retval = *this; return retval -= offset; }
+    friend constexpr auto operator+(difference_type offset, index_iterator it) -> index_iterator { return it += offset; }
+
+    constexpr auto operator-(index_iterator const& other) const -> difference_type { return m_idx - other.m_idx; }
+
+    constexpr auto operator==(index_iterator const& other) const -> bool { return m_idx == other.m_idx; }
+    constexpr auto operator<=>(index_iterator const& other) const -> std::strong_ordering { return m_idx <=> other.m_idx; }
+
+    constexpr auto operator* () const -> reference { return  (*m_container)[static_cast<std::size_t>(m_idx)]; }
+    constexpr auto operator->() const -> pointer   { return &(*m_container)[static_cast<std::size_t>(m_idx)]; }
+    constexpr auto operator[](difference_type offset) const -> reference {
+        return (*m_container)[static_cast<std::size_t>(m_idx + offset)];
+    }
+};
+
+}  // namespace dsc
@@ -0,0 +1,322 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "dsc/heap.hpp"
+#include "dsc/ring_vector.hpp"
+
+namespace dsc {
+
+/** Addressable heap. push returns a handle which stays valid while its element is in the heap, and through which the
+ *  element's priority can be changed or the element erased in O(log n), so callers such as Dijkstra's algorithm or a
+ *  timeout scheduler never need to push duplicates and skip stale entries.
+ *
+ *  Keys are held in their own array laid out like heap, with a parallel array of the id at each position and a table
+ *  from id to current position which every sift keeps up to date. Ids of removed elements are reused by later pushes,
+ *  so a handle must not be used once its element has been popped or erased. */
+template <typename T, typename HeapType, typename Allocator = std::allocator<T>, std::size_t Arity = 2>
+requires std::three_way_comparable<T> &&
+         std::disjunction_v<std::is_same<HeapType, min_heap>,
+                            std::is_same<HeapType, max_heap>> &&
+         (Arity >= 2)
+class indexed_heap {
+ public:
+    using value_type        = T;
+    using allocator_type    = Allocator;
+    using size_type         = std::size_t;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+
+    /** Refers to one element of the heap for as long as it is in the heap */
+    class handle {
+     public:
+        handle() = default;
+
+        auto operator==(handle const& other) const -> bool = default;
+
+     private:
+        friend class indexed_heap;
+
+        explicit handle(size_type id): id_(id) {}
+
+        size_type id_ = std::numeric_limits<size_type>::max();
+    };
+
+ private:
+    using idx_t       = size_type;
+    using idx_alloc_t = typename std::allocator_traits<Allocator>::template rebind_alloc<idx_t>;
+
+    static constexpr idx_t npos = std::numeric_limits<idx_t>::max();
+
+    ring_vector<T, Allocator>        keys_;
+    ring_vector<idx_t, idx_alloc_t>  ids_;
+    // Position of each live id in keys_, or the next id in the free list for removed ids
+    ring_vector<idx_t, idx_alloc_t>  slots_;
+    idx_t                            free_;
+
+    /* Determines higher priority element given the heap type */
+    auto is_better(T const& a, T const& b) const -> bool {
+        if constexpr(std::is_same_v<HeapType, min_heap>) {
+            return a < b;
+        } else {
+            return a > b;
+        }
+    }
+
+    static auto parent(idx_t child) -> idx_t { return (child-1) / Arity; }
+
+    static auto first_child(idx_t parent) -> idx_t { return parent*Arity + 1; }
+
+    /** Records that id now lives at pos */
+    auto place(idx_t pos, idx_t id) -> void {
+        ids_[pos]   = id;
+        slots_[id]  = pos;
+    }
+
+    /** Returns the index of the best of the children starting at first */
+    auto best_child(idx_t first) const -> idx_t {
+        idx_t last = std::min<idx_t>(first + Arity, keys_.size());
+        idx_t best = first;
+        for (idx_t idx=first+1; idx < last; idx++) {
+            if (is_better(keys_[idx], keys_[best])) {
+                best = idx;
+            }
+        }
+        return best;
+    }
+
+    /** Moves the element at pos up while it is better than its parent, moving parents down into the hole and
+     *  updating their positions as it goes */
+    auto sift_up(idx_t pos) -> void {
+        if (pos == 0 || !is_better(keys_[pos], keys_[parent(pos)])) {
+            return;
+        }
+
+        T     key = std::move(keys_[pos]);
+        idx_t id  = ids_[pos];
+        do {
+            idx_t parent_idx = parent(pos);
+            keys_[pos] = std::move(keys_[parent_idx]);
+            place(pos, ids_[parent_idx]);
+            pos = parent_idx;
+        } while (pos > 0 && is_better(key, keys_[parent(pos)]));
+        keys_[pos] = std::move(key);
+        place(pos, id);
+    }
+
+    /** Moves the element at pos down while one of its children is better, moving children up into the hole and
+     *  updating their positions as it goes */
+    auto sift_down(idx_t pos) -> void {
+        idx_t size = keys_.size();
+        if (first_child(pos) >= size || !is_better(keys_[best_child(first_child(pos))], keys_[pos])) {
+            return;
+        }
+
+        T     key = std::move(keys_[pos]);
+        idx_t id  = ids_[pos];
+        for (idx_t child_idx = first_child(pos); child_idx < size; child_idx = first_child(pos)) {
+            idx_t next_idx = best_child(child_idx);
+            if (!is_better(keys_[next_idx], key)) {
+                break;
+            }
+            keys_[pos] = std::move(keys_[next_idx]);
+            place(pos, ids_[next_idx]);
+            pos = next_idx;
+        }
+        keys_[pos] = std::move(key);
+        place(pos, id);
+    }
+
+    /** Restores heap order around pos after its key changed in either direction */
+    auto restore(idx_t pos) -> void {
+        if (pos > 0 && is_better(keys_[pos], keys_[parent(pos)])) {
+            sift_up(pos);
+        } else {
+            sift_down(pos);
+        }
+    }
+
+    /** Returns an unused id, reusing a removed one if there is any */
+    auto acquire_id() -> idx_t {
+        if (free_ != npos) {
+            return std::exchange(free_, slots_[free_]);
+        }
+        slots_.push_back(npos);
+        return slots_.size() - 1;
+    }
+
+    /** Removes the element at pos, filling the hole with the last element, and frees its id */
+    auto remove_at(idx_t pos) -> void {
+        idx_t id   = ids_[pos];
+        idx_t last = keys_.size() - 1;
+        if (pos != last) {
+            keys_[pos] = std::move(keys_[last]);
+            place(pos, ids_[last]);
+        }
+        keys_.pop_back();
+        ids_.pop_back();
+
+        slots_[id] = free_;
+        free_      = id;
+
+        if (pos != last) {
+            restore(pos);
+        }
+    }
+
+    auto position(handle h) const -> idx_t { return slots_[h.id_]; }
+
+ public:
+    /** Construct an empty heap which allocates through alloc */
+    explicit indexed_heap(Allocator const& alloc = Allocator()): keys_(alloc),
+                                                                 ids_(idx_alloc_t(alloc)),
+                                                                 slots_(idx_alloc_t(alloc)),
+                                                                 free_(npos) {}
+
+    /** Returns a copy of the allocator */
+    auto get_allocator() const -> allocator_type { return keys_.get_allocator(); }
+
+
+    /* ========================================================== */
+    /* ====================  ELEMENT ACCESS  ==================== */
+
+    /** Returns the best element */
+    auto top() const -> const_reference { return keys_[0]; }
+
+    /** Returns the handle of the best element */
+    auto top_handle() const -> handle { return handle{ids_[0]}; }
+
+    /** Returns the element h refers to. Change it with update, decrease_key or increase_key. */
+    auto operator[](handle h) const -> const_reference { return keys_[position(h)]; }
+
+    /** Returns true if h refers to an element which is still in the heap. A handle whose element was removed reports
+     *  true again once its id is reused by a later push. */
+    auto contains(handle h) const -> bool {
+        return h.id_ < slots_.size() && slots_[h.id_] < keys_.size() && ids_[slots_[h.id_]] == h.id_;
+    }
+
+
+    /* ========================================================== */
+    /* ========================  CAPACITY  ====================== */
+
+    /** Returns true if there are no elements */
+    auto empty() const -> bool { return keys_.empty(); }
+
+    /** Returns number of elements */
+    auto size() const -> size_type { return keys_.size(); }
+
+    /** Reserves space for count elements, so pushes up to that size do not allocate */
+    auto reserve(size_type count) -> void {
+        keys_.reserve(count);
+        ids_.reserve(count);
+        slots_.reserve(count);
+    }
+
+
+    /* ========================================================== */
+    /* ========================  MODIFIERS  ===================== */
+
+    /** Constructs an element from params and returns its handle */
+    template <typename... Params>
+    auto push(Params&&... params) -> handle {
+        idx_t id  = acquire_id();
+        idx_t pos = keys_.size();
+        keys_.emplace_back(std::forward<Params>(params)...);
+        ids_.push_back(id);
+        slots_[id] = pos;
+        sift_up(pos);
+        return handle{id};
+    }
+
+    /** Removes and returns the best element */
+    auto pop() -> T {
+        T popped = std::move(keys_[0]);
+        remove_at(0);
+        return popped;
+    }
+
+    /** Removes the element h refers to in O(log n) */
+    auto erase(handle h) -> void {
+        remove_at(position(h));
+    }
+
+    /** Replaces the element h refers to with value, moving it whichever way the new value requires */
+    template<typename U = T>
+    requires std::assignable_from<T&, U&&>
+    auto update(handle h, U&& value) -> void {
+        idx_t pos = position(h);
+        keys_[pos] = std::forward<U>(value);
+        restore(pos);
+    }
+
+    /** Changes the element h refers to through f, which is given a reference to it, then restores heap order */
+    template<typename F>
+    requires std::invocable<F&, T&>
+    auto modify(handle h, F f) -> void {
+        idx_t pos = position(h);
+        f(keys_[pos]);
+        restore(pos);
+    }
+
+    /** Restores heap order after the element h refers to changed, for elements whose priority depends on state
+     *  outside the heap */
+    auto update(handle h) -> void {
+        restore(position(h));
+    }
+
+    /** Replaces the element h refers to with a value no greater than it, which can only move it towards the top of a
+     *  min heap and towards the bottom of a max heap */
+    template<typename U = T>
+    requires std::assignable_from<T&, U&&>
+    auto decrease_key(handle h, U&& value) -> void {
+        idx_t pos = position(h);
+        keys_[pos] = std::forward<U>(value);
+        if constexpr (std::is_same_v<HeapType, min_heap>) {
+            sift_up(pos);
+        } else {
+            sift_down(pos);
+        }
+    }
+
+    /** Replaces the element h refers to with a value no less than it, which can only move it towards the bottom of a
+     *  min heap and towards the top of a max heap */
+    template<typename U = T>
+    requires std::assignable_from<T&, U&&>
+    auto increase_key(handle h, U&& value) -> void {
+        idx_t pos = position(h);
+        keys_[pos] = std::forward<U>(value);
+        if constexpr (std::is_same_v<HeapType, min_heap>) {
+            sift_down(pos);
+        } else {
+            sift_up(pos);
+        }
+    }
+
+    /** Removes every element. Every handle becomes invalid. */
+    auto clear() -> void {
+        keys_.clear();
+        ids_.clear();
+        slots_.clear();
+        free_ = npos;
+    }
+};
+
+namespace pmr {
+
+/** indexed_heap which allocates from a std::pmr::memory_resource */
+template<typename T, typename HeapType, std::size_t Arity = 2>
+using indexed_heap = dsc::indexed_heap<T, HeapType, std::pmr::polymorphic_allocator<T>, Arity>;
+
+}  // namespace pmr
+
+}  // namespace dsc
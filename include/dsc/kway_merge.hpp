@@ -0,0 +1,304 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dsc/heap.hpp"
+
+namespace dsc {
+
+/** How kway_merge picks the next element */
+enum class merge_strategy {
+    /** Tournament tree holding the loser of each match, replayed from one leaf to the root per element with exactly
+     *  one comparison per level. The fewest comparisons, for elements such as strings which are costly to compare. */
+    loser_tree,
+    /** dsc::heap of the head of each run, whose top is replaced per element. About twice the comparisons of the loser
+     *  tree, but the new head usually sinks to the bottom, so its branches are predictable, which wins when
+     *  comparisons are a single instruction. */
+    heap,
+};
+
+/** True when elements of T which compare equal under Compare are indistinguishable and cheap to compare, as for
+ *  numbers under std::less or std::greater */
+template<typename T, typename Compare>
+inline constexpr bool plain_ordering = std::is_arithmetic_v<T> &&
+                                       (std::same_as<Compare, std::less<>>    || std::same_as<Compare, std::greater<>> ||
+                                        std::same_as<Compare, std::less<T>>   || std::same_as<Compare, std::greater<T>>);
+
+/** The elements of the runs of Runs */
+template<typename Runs>
+using run_value_t = std::ranges::range_value_t<std::remove_reference_t<std::ranges::range_reference_t<Runs>>>;
+
+/** Lazy merge of k sorted runs, such as per shard results or per thread sorted buffers, into one sorted input range.
+ *  Nothing is merged up front: each increment of the iterator advances one run and replays one path of the tree.
+ *  Each node of the tree holds the head element of a run, so matches compare contiguous memory rather than chasing
+ *  each run's iterator. Small trivially copyable elements, and those of single pass input runs, are copied into the
+ *  node; larger ones such as strings are pointed to in place. Equal elements come out in the order of their runs, so
+ *  the merge is stable.
+ *
+ *  The strategy defaults to the heap for numbers under std::less or std::greater and to the loser tree otherwise.
+ *
+ *  runs must outlive the merge, and the merge is a single pass range: begin() can only be called once. */
+template<std::ranges::input_range Runs,
+         typename Compare = std::less<>,
+         merge_strategy Strategy = plain_ordering<run_value_t<Runs>, Compare> ? merge_strategy::heap
+                                                                               : merge_strategy::loser_tree>
+requires std::ranges::input_range<std::remove_reference_t<std::ranges::range_reference_t<Runs>>>
+class kway_merge {
+    using run_t = std::remove_reference_t<std::ranges::range_reference_t<Runs>>;
+
+ public:
+    using value_type      = std::ranges::range_value_t<run_t>;
+    using size_type       = std::size_t;
+    using reference       = value_type const&;
+
+ private:
+    using idx_t      = size_type;
+    using iterator_t = std::ranges::iterator_t<run_t>;
+    using sentinel_t = std::ranges::sentinel_t<run_t>;
+
+    /** Marks the entry of an exhausted run, which loses every match */
+    static constexpr idx_t npos = std::numeric_limits<idx_t>::max();
+
+    /** True if entries copy head elements rather than point to them in their runs */
+    static constexpr bool holds_values =
+        !(std::ranges::forward_range<run_t> && std::is_lvalue_reference_v<std::ranges::range_reference_t<run_t>>) ||
+        (std::is_trivially_copyable_v<value_type> && sizeof(value_type) <= 2*sizeof(void*));
+
+    using held_t = std::conditional_t<holds_values, value_type, value_type const*>;
+
+    /** Head element of a run, and the run it came from */
+    struct entry {
+        held_t head;
+        idx_t  run;
+
+        auto value() const -> value_type const& {
+            if constexpr (holds_values) {
+                return head;
+            } else {
+                return *head;
+            }
+        }
+    };
+
+    /** Orders entries by value, and equal values by run, with one comparison. Entries of exhausted runs go last. */
+    struct entry_order {
+        [[no_unique_address]] Compare comp;
+
+        auto operator()(entry const& a, entry const& b) const -> bool {
+            if (a.run == npos || b.run == npos) {
+                return b.run == npos && a.run != npos;
+            }
+            if constexpr (plain_ordering<value_type, Compare>) {
+                // Ties are indistinguishable, so their order need not be kept
+                return std::invoke(comp, a.value(), b.value());
+            } else if (a.run < b.run) {
+                return !std::invoke(comp, b.value(), a.value());
+            } else {
+                return std::invoke(comp, a.value(), b.value());
+            }
+        }
+    };
+
+    struct empty_state {};
+    using heap_t = std::conditional_t<Strategy == merge_strategy::heap,
+                                      heap<entry, heap_order<entry_order>>,
+                                      empty_state>;
+
+    // Only runs which were not empty to begin with, in their original order
+    std::vector<iterator_t>             heads_;
+    std::vector<sentinel_t>             ends_;
+    // Loser tree: tree_[0] is the winning entry, and node n of 1 to k-1 holds the entry which lost the match there.
+    // Leaf k+i is run i, and the parent of node n is n/2.
+    std::vector<entry>                  tree_;
+    [[no_unique_address]] heap_t        heap_;
+    [[no_unique_address]] entry_order   order_;
+    size_type                           runs_;
+
+    /** Returns the element at it, or its address */
+    static auto held(iterator_t const& it) -> held_t {
+        if constexpr (holds_values) {
+            return *it;
+        } else {
+            return std::addressof(*it);
+        }
+    }
+
+    /** Returns the next entry of run, moving the run past it */
+    auto take(idx_t run) -> entry {
+        entry next{held(heads_[run]), run};
+        ++heads_[run];
+        return next;
+    }
+
+    /** Plays every match bottom up, leaving the loser at each node and the overall winner at the root */
+    auto build_tree() -> void {
+        idx_t k = heads_.size();
+        if (k == 0) {
+            return;
+        }
+        auto leaves = std::vector<entry>{};
+        leaves.reserve(k);
+        for (idx_t run=0; run < k; run++) {
+            leaves.push_back(take(run));
+        }
+
+        // Leaves are moved into the tree once every match is played, so matches are played on leaf indices
+        auto winners = std::vector<idx_t>(2*k);
+        auto losers  = std::vector<idx_t>(k);
+        for (idx_t run=0; run < k; run++) {
+            winners[k + run] = run;
+        }
+        for (idx_t node = k; node-- > 1;) {
+            idx_t a = winners[2*node];
+            idx_t b = winners[2*node + 1];
+            bool  a_wins = order_(leaves[a], leaves[b]);
+            winners[node] = a_wins ? a : b;
+            losers[node]  = a_wins ? b : a;
+        }
+        losers[0] = winners[1];
+
+        tree_.reserve(k);
+        for (idx_t node=0; node < k; node++) {
+            tree_.push_back(std::move(leaves[losers[node]]));
+        }
+    }
+
+    /** Refills the winner from its run and replays its path to the root, one comparison per level */
+    auto advance_tree() -> void {
+        idx_t k      = heads_.size();
+        idx_t run    = tree_[0].run;
+        entry winner = std::move(tree_[0]);
+        if (heads_[run] == ends_[run]) {
+            // The last head stays in the entry, so the exhausted run can still be compared against
+            winner.run = npos;
+        } else {
+            winner = take(run);
+        }
+        for (idx_t node = (run + k) / 2; node > 0; node /= 2) {
+            if (order_(tree_[node], winner)) {
+                std::swap(tree_[node], winner);
+            }
+        }
+        tree_[0] = std::move(winner);
+    }
+
+    static auto make_heap(entry_order const& order) -> heap_t {
+        if constexpr (Strategy == merge_strategy::heap) {
+            return heap_t(heap_order<entry_order>{order, {}});
+        } else {
+            return heap_t{};
+        }
+    }
+
+    /** Pushes the head of every run onto the heap */
+    auto build_heap() -> void {
+        heap_.reserve(heads_.size());
+        for (idx_t run=0; run < heads_.size(); run++) {
+            heap_.push(take(run));
+        }
+    }
+
+    /** Replaces the top of the heap with the next element of its run, or pops it if the run is exhausted */
+    auto advance_heap() -> void {
+        idx_t run = heap_.front().run;
+        if (heads_[run] == ends_[run]) {
+            heap_.pop();
+        } else {
+            heap_.replace_top(take(run));
+        }
+    }
+
+ public:
+    /** Single pass iterator over the merged elements */
+    class iterator {
+     private:
+        kway_merge* merge_ = nullptr;
+
+     public:
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = kway_merge::value_type;
+        using reference         = kway_merge::reference;
+        using iterator_concept  = std::input_iterator_tag;
+
+        iterator() = default;
+        explicit iterator(kway_merge& merge): merge_(&merge) {}
+
+        auto operator*() const -> reference { return merge_->front(); }
+
+        auto operator++()    -> iterator& { merge_->pop(); return *this; }
+        auto operator++(int) -> void      { ++(*this); }
+
+        friend auto operator==(iterator const& it, std::default_sentinel_t) -> bool { return it.merge_->empty(); }
+    };
+
+    /** Merges runs, each sorted by comp */
+    explicit kway_merge(Runs& runs, Compare comp = Compare()): heap_(make_heap(entry_order{comp})),
+                                                               order_{std::move(comp)},
+                                                               runs_(0) {
+        for (auto& run: runs) {
+            auto first = std::ranges::begin(run);
+            auto last  = std::ranges::end(run);
+            runs_++;
+            if (first != last) {
+                heads_.push_back(std::move(first));
+                ends_.push_back(std::move(last));
+            }
+        }
+        if constexpr (Strategy == merge_strategy::loser_tree) {
+            build_tree();
+        } else {
+            build_heap();
+        }
+    }
+
+    /** Returns the number of runs */
+    auto runs() const -> size_type { return runs_; }
+
+    /** Returns true if every element has been taken */
+    auto empty() const -> bool {
+        if constexpr (Strategy == merge_strategy::loser_tree) {
+            return tree_.empty() || tree_[0].run == npos;
+        } else {
+            return heap_.empty();
+        }
+    }
+
+    /** Returns the next element without taking it */
+    auto front() const -> reference {
+        if constexpr (Strategy == merge_strategy::loser_tree) {
+            return tree_[0].value();
+        } else {
+            return heap_.front().value();
+        }
+    }
+
+    /** Takes the next element */
+    auto pop() -> void {
+        if constexpr (Strategy == merge_strategy::loser_tree) {
+            advance_tree();
+        } else {
+            advance_heap();
+        }
+    }
+
+    auto begin() -> iterator { return iterator{*this}; }
+
+    auto end() const -> std::default_sentinel_t { return std::default_sentinel; }
+};
+
+template<typename Runs, typename Compare = std::less<>>
+kway_merge(Runs&, Compare = Compare()) -> kway_merge<Runs, Compare>;
+
+}  // namespace dsc
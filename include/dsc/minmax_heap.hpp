@@ -0,0 +1,245 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "dsc/heap.hpp"
+
+namespace dsc {
+
+/** Double ended priority queue with O(1) min() and max() and O(log n) push, pop_min() and pop_max().
+ *
+ *  Elements are kept in one array as a min-max heap: nodes on even depths are no greater than every element below
+ *  them, and nodes on odd depths no less. The smallest element is the root and the largest is one of its two
+ *  children. The array, its growth, copies, moves and allocator handling are those of heap, which this derives from,
+ *  so both ends cost one array rather than the two of a min heap and a max heap side by side.
+ *
+ *  Compare orders elements the way std::less<> does. */
+template<typename T, typename Compare = std::less<>, typename Allocator = std::allocator<T>>
+requires heap_ordering<heap_order<Compare>, T>
+class minmax_heap : private heap<T, heap_order<Compare>, Allocator> {
+    using base = heap<T, heap_order<Compare>, Allocator>;
+    using typename base::idx_t;
+    using typename base::allc_tr;
+    using base::elems_;
+    using base::size_;
+    using base::alloc_;
+
+    auto less(T const& a, T const& b) const -> bool { return this->is_better(a, b); }
+
+    static auto parent(idx_t child) -> idx_t { return (child-1) / 2; }
+
+    /** Returns true if idx is on an even depth, where nodes are the smallest of their subtree */
+    static auto on_min_level(idx_t idx) -> bool { return std::bit_width(idx + 1) % 2 == 1; }
+
+    /** Returns the index of the smallest, or with Max the largest, of the children and grandchildren of idx. idx must
+     *  have at least one child. */
+    template<bool Max>
+    auto extreme_descendant(idx_t idx) const -> idx_t {
+        auto better = [this](idx_t a, idx_t b) { return Max ? less(elems_[b], elems_[a]) : less(elems_[a], elems_[b]); };
+
+        idx_t first = 2*idx + 1;
+        idx_t best  = first;
+        if (first + 1 < size_ && better(first + 1, best)) {
+            best = first + 1;
+        }
+        // Grandchildren are contiguous, from the first child of the first child to the last child of the second
+        for (idx_t grandchild = 4*idx + 3; grandchild < size_ && grandchild <= 4*idx + 6; grandchild++) {
+            if (better(grandchild, best)) {
+                best = grandchild;
+            }
+        }
+        return best;
+    }
+
+    /** Moves value up through the grandparents of the hole at idx, which are all on min levels, or with Max all on
+     *  max levels, for as long as value is better than them, then places it */
+    template<bool Max, typename V>
+    auto bubble_up(idx_t idx, V&& value) -> void {
+        while (idx > 2) {
+            idx_t grandparent = parent(parent(idx));
+            if (!(Max ? less(elems_[grandparent], value) : less(value, elems_[grandparent]))) {
+                break;
+            }
+            elems_[idx] = std::move(elems_[grandparent]);
+            idx = grandparent;
+        }
+        elems_[idx] = std::forward<V>(value);
+    }
+
+    /** Orders the newly appended element at idx by first deciding whether it belongs on the min or the max levels
+     *  above it */
+    auto sift_up(idx_t idx) -> void {
+        if (idx == 0) {
+            return;
+        }
+
+        idx_t p = parent(idx);
+        if (on_min_level(idx)) {
+            if (less(elems_[p], elems_[idx])) {
+                T value = std::move(elems_[idx]);
+                elems_[idx] = std::move(elems_[p]);
+                bubble_up<true>(p, std::move(value));
+            } else if (idx > 2 && less(elems_[idx], elems_[parent(p)])) {
+                bubble_up<false>(idx, T(std::move(elems_[idx])));
+            }
+        } else {
+            if (less(elems_[idx], elems_[p])) {
+                T value = std::move(elems_[idx]);
+                elems_[idx] = std::move(elems_[p]);
+                bubble_up<false>(p, std::move(value));
+            } else if (idx > 2 && less(elems_[parent(p)], elems_[idx])) {
+                bubble_up<true>(idx, T(std::move(elems_[idx])));
+            }
+        }
+    }
+
+    /** Fills the hole at idx, which is on a min level, or with Max on a max level, with value. The best descendant
+     *  moves up into the hole while it is better than value. When it came from a grandchild, value may be worse than
+     *  the child between them, in which case the two are exchanged before carrying on from the grandchild. */
+    template<bool Max>
+    auto trickle_down(idx_t idx, T value) -> void {
+        auto better = [this](T const& a, T const& b) { return Max ? less(b, a) : less(a, b); };
+
+        while (2*idx + 1 < size_) {
+            idx_t best = extreme_descendant<Max>(idx);
+            if (!better(elems_[best], value)) {
+                break;
+            }
+            bool from_grandchild = best >= 4*idx + 3;
+            elems_[idx] = std::move(elems_[best]);
+            idx = best;
+            if (!from_grandchild) {
+                // A child has no descendants on the levels of value, so the hole is its place
+                break;
+            }
+            // Keep value on the right side of the child between the hole and its old position
+            if (better(elems_[parent(idx)], value)) {
+                std::swap(value, elems_[parent(idx)]);
+            }
+        }
+        elems_[idx] = std::move(value);
+    }
+
+    /** Removes the element at idx, whose value has already been moved out, filling it with the last element */
+    template<bool Max>
+    auto remove_at(idx_t idx) -> void {
+        size_--;
+        if (idx < size_) {
+            trickle_down<Max>(idx, std::move(elems_[size_]));
+        }
+        allc_tr::destroy(alloc_, elems_+size_);
+    }
+
+    /** Returns the index of the largest element. The heap must not be empty. */
+    auto max_index() const -> idx_t {
+        if (size_ == 1) {
+            return 0;
+        }
+        if (size_ == 2 || !less(elems_[1], elems_[2])) {
+            return 1;
+        }
+        return 2;
+    }
+
+ public:
+    using typename base::value_type;
+    using typename base::allocator_type;
+    using typename base::size_type;
+    using typename base::reference;
+    using typename base::const_reference;
+
+    /** Construct an empty heap with a minimum memory capacity, allocating through alloc */
+    explicit minmax_heap(idx_t min_capacity = 16, Allocator const& alloc = Allocator()): base(min_capacity, alloc) {}
+
+    /** Construct an empty heap which allocates through alloc */
+    explicit minmax_heap(Allocator const& alloc): base(16, alloc) {}
+
+    /** Construct a heap holding every element of range, built bottom up in O(n) */
+    template<std::ranges::input_range R>
+    requires (!std::same_as<std::remove_cvref_t<R>, minmax_heap>) &&
+             std::constructible_from<T, std::ranges::range_reference_t<R>>
+    explicit minmax_heap(R&& range, Allocator const& alloc = Allocator()): base(16, alloc) {
+        for (auto&& value: range) {
+            this->grow_if_full();
+            allc_tr::construct(alloc_, elems_+size_, std::forward<decltype(value)>(value));
+            size_++;
+        }
+        if (size_ < 2) {
+            return;
+        }
+        for (idx_t idx = parent(size_-1) + 1; idx-- > 0;) {
+            if (on_min_level(idx)) {
+                trickle_down<false>(idx, std::move(elems_[idx]));
+            } else {
+                trickle_down<true>(idx, std::move(elems_[idx]));
+            }
+        }
+    }
+
+    using base::get_allocator;
+    using base::empty;
+    using base::size;
+    using base::capacity;
+    using base::reserve;
+    using base::shrink_to_fit;
+    using base::clear;
+
+
+    /* ========================================================== */
+    /* ====================  ELEMENT ACCESS  ==================== */
+
+    /** Returns the smallest element */
+    auto min() const -> const_reference { return elems_[0]; }
+
+    /** Returns the largest element */
+    auto max() const -> const_reference { return elems_[max_index()]; }
+
+
+    /* ========================================================== */
+    /* ========================  MODIFIERS  ===================== */
+
+    /** Constructs an element from params in place and moves it to its level */
+    template <typename... Params>
+    auto push(Params&&... params) -> void {
+        this->grow_if_full();
+        allc_tr::construct(alloc_, elems_+size_, std::forward<Params>(params)...);
+        size_++;
+        sift_up(size_-1);
+    }
+
+    /** Removes and returns the smallest element */
+    auto pop_min() -> T {
+        T popped = std::move(elems_[0]);
+        remove_at<false>(0);
+        return popped;
+    }
+
+    /** Removes and returns the largest element */
+    auto pop_max() -> T {
+        idx_t idx    = max_index();
+        T     popped = std::move(elems_[idx]);
+        remove_at<true>(idx);
+        return popped;
+    }
+
+    auto swap(minmax_heap& other) noexcept -> void { base::swap(other); }
+};
+
+namespace pmr {
+
+/** minmax_heap which allocates from a std::pmr::memory_resource */
+template<typename T, typename Compare = std::less<>>
+using minmax_heap = dsc::minmax_heap<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace dsc
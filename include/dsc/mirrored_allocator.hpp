@@ -0,0 +1,87 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+
+namespace dsc {
+
+/** Allocator which maps the same memory twice, back to back, in virtual memory. Element capacity + i is element i, so
+ *  a ring buffer built on it can view any window of its elements as one contiguous range even when the window wraps
+ *  around the end of the array. The backing memory comes from a memfd, and both mappings must cover whole pages, so
+ *  allocation sizes must be a multiple of min_capacity(). Linux only. */
+template<typename T>
+class mirrored_allocator {
+ public:
+    using value_type = T;
+
+    /** Marks storage where element capacity + i aliases element i */
+    static constexpr bool mirrored = true;
+
+    mirrored_allocator() = default;
+
+    template<typename U>
+    mirrored_allocator(mirrored_allocator<U> const&) noexcept {}
+
+    /** Returns the smallest element count which fills whole pages. Every allocation size must be a multiple of this. */
+    static auto min_capacity() -> std::size_t {
+        auto page = page_size();
+        return page / std::gcd(page, sizeof(T));
+    }
+
+    /** Maps n elements followed by a mirror of the same n elements. n must be a multiple of min_capacity(). */
+    auto allocate(std::size_t n) -> T* {
+        if (n == 0 || n % min_capacity() != 0) {
+            throw std::invalid_argument{"mirrored_allocator: size must be a multiple of min_capacity()"};
+        }
+
+        auto bytes = n * sizeof(T);
+        auto fd    = memfd_create("dsc_mirrored", MFD_CLOEXEC);
+        if (fd < 0) {
+            throw std::bad_alloc{};
+        }
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            close(fd);
+            throw std::bad_alloc{};
+        }
+
+        // Reserve the address range for both halves first so nothing else can be mapped between them
+        auto* base = static_cast<char*>(mmap(nullptr, 2*bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (base == MAP_FAILED) {
+            close(fd);
+            throw std::bad_alloc{};
+        }
+
+        auto* first  = mmap(base,         bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+        auto* second = mmap(base + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+        close(fd);
+
+        if (first == MAP_FAILED || second == MAP_FAILED) {
+            munmap(base, 2*bytes);
+            throw std::bad_alloc{};
+        }
+        return reinterpret_cast<T*>(base);
+    }
+
+    /** Unmaps both halves of memory previously returned by allocate with the same element count */
+    auto deallocate(T* array, std::size_t n) -> void {
+        if (array) {
+            munmap(array, 2 * n * sizeof(T));
+        }
+    }
+
+    friend auto operator==(mirrored_allocator const&, mirrored_allocator const&) -> bool { return true; }
+
+ private:
+    static auto page_size() -> std::size_t {
+        return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    }
+};
+
+}  // namespace dsc
@@ -0,0 +1,63 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace dsc {
+
+/** Allocator which maps memory directly from the kernel with mmap. Beyond the standard allocator interface it provides
+ *  reallocate(), which resizes a mapping with mremap. Growing a mapping only rewrites page tables, so no elements are
+ *  copied, and pages of the grown region are not committed until they are touched. Every allocation is rounded up to
+ *  whole pages, so this is meant for large buffers. Linux only. */
+template<typename T>
+class mmap_allocator {
+ public:
+    using value_type = T;
+
+    mmap_allocator() = default;
+
+    template<typename U>
+    mmap_allocator(mmap_allocator<U> const&) noexcept {}
+
+    /** Maps enough anonymous pages to hold n elements */
+    auto allocate(std::size_t n) -> T* {
+        void* mem = mmap(nullptr, map_size(n), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED) {
+            throw std::bad_alloc{};
+        }
+        return static_cast<T*>(mem);
+    }
+
+    /** Unmaps memory previously returned by allocate or reallocate with the same element count */
+    auto deallocate(T* array, std::size_t n) -> void {
+        if (array) {
+            munmap(array, map_size(n));
+        }
+    }
+
+    /** Resizes a mapping of old_n elements to hold new_n elements, keeping its contents. The mapping may move, in which
+     *  case the pages are moved rather than copied. */
+    auto reallocate(T* array, std::size_t old_n, std::size_t new_n) -> T* {
+        void* mem = mremap(array, map_size(old_n), map_size(new_n), MREMAP_MAYMOVE);
+        if (mem == MAP_FAILED) {
+            throw std::bad_alloc{};
+        }
+        return static_cast<T*>(mem);
+    }
+
+    friend auto operator==(mmap_allocator const&, mmap_allocator const&) -> bool { return true; }
+
+ private:
+    static auto map_size(std::size_t n) -> std::size_t {
+        auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return (std::max<std::size_t>(n * sizeof(T), 1) + page - 1) / page * page;
+    }
+};
+
+}  // namespace dsc
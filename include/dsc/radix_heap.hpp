@@ -0,0 +1,225 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "dsc/ring_vector.hpp"
+
+namespace dsc {
+
+/** Keys a radix_heap can order by their bits: unsigned integers, and floats and doubles other than NaN */
+template<typename Key>
+concept radix_key = (std::unsigned_integral<Key> && !std::same_as<Key, bool>) ||
+                    std::same_as<Key, float> || std::same_as<Key, double>;
+
+/** Min priority queue of (key, value) pairs for monotone keys, such as the timestamps of a discrete event simulator,
+ *  where no key pushed is smaller than the last key taken from top() or pop().
+ *
+ *  Elements are kept in one bucket per bit of the key, plus one for keys equal to the last key taken. An element
+ *  goes to the bucket of the highest bit in which its key differs from the last key taken, so a push is a few bit
+ *  operations and an append, with no comparisons. When the bucket of equal keys runs out, the lowest nonempty bucket
+ *  is scanned for its minimum, which becomes the last key, and its elements are spread over the buckets below it.
+ *  Each element can only move down, so it is moved at most once per bit of the key and a pop costs amortised
+ *  O(log C) for keys spanning a range of C, with sequential scans instead of the cache misses of a binary heap.
+ *
+ *  Buckets are ring_vectors, which keep their capacity as they empty and fill, so a steady state simulation stops
+ *  allocating. Floating point keys are mapped to unsigned integers of the same width which order the same way. */
+template<radix_key Key, typename Value, typename Allocator = std::allocator<std::pair<Key, Value>>>
+class radix_heap {
+ public:
+    using key_type          = Key;
+    using mapped_type       = Value;
+    using value_type        = std::pair<Key, Value>;
+    using allocator_type    = Allocator;
+    using size_type         = std::size_t;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+
+ private:
+    using bits_t   = std::conditional_t<std::is_floating_point_v<Key>,
+                                        std::conditional_t<sizeof(Key) == 4, std::uint32_t, std::uint64_t>,
+                                        Key>;
+    using bucket_t = ring_vector<value_type, Allocator>;
+
+    static constexpr size_type key_bits = std::numeric_limits<bits_t>::digits;
+
+    // Bucket 0 holds keys equal to last_, and bucket b of 1 to key_bits holds keys whose highest bit differing from
+    // last_ is bit b-1
+    std::array<bucket_t, key_bits + 1> buckets_;
+    // Bit b-1 is set when bucket b is not empty
+    bits_t                             occupied_;
+    bits_t                             last_;
+    size_type                          size_;
+
+    /** Returns key as an unsigned integer in the same order. Negative floats have every bit flipped and positive
+     *  ones their sign bit set, and -0.0 is taken as 0.0 so the two compare equal as they do as floats. */
+    static constexpr auto bits_of(Key key) -> bits_t {
+        if constexpr (std::is_floating_point_v<Key>) {
+            constexpr bits_t sign = bits_t{1} << (key_bits - 1);
+            bits_t bits = std::bit_cast<bits_t>(key == Key{0} ? Key{0} : key);
+            return (bits & sign) ? ~bits : bits | sign;
+        } else {
+            return key;
+        }
+    }
+
+    /** Returns the smallest key bits_of can return, below which nothing has been taken */
+    static constexpr auto lowest_bits() -> bits_t {
+        if constexpr (std::is_floating_point_v<Key>) {
+            return bits_of(-std::numeric_limits<Key>::infinity());
+        } else {
+            return 0;
+        }
+    }
+
+    /** Returns the bucket for bits, against the last key taken */
+    auto bucket_of(bits_t bits) const -> size_type {
+        return static_cast<size_type>(std::bit_width(static_cast<bits_t>(bits ^ last_)));
+    }
+
+    /** Appends value to the bucket for bits */
+    auto place(bits_t bits, value_type&& value) -> void {
+        size_type b = bucket_of(bits);
+        buckets_[b].push_back(std::move(value));
+        if (b != 0) {
+            occupied_ |= bits_t{1} << (b - 1);
+        }
+    }
+
+    /** Makes the minimum key the last key taken and spreads the lowest nonempty bucket over the buckets below it, so
+     *  bucket 0 holds the minimum. Bucket 0 must be empty and the heap must not be. */
+    auto refill() -> void {
+        size_type b      = static_cast<size_type>(std::countr_zero(occupied_)) + 1;
+        bucket_t& bucket = buckets_[b];
+        occupied_ &= occupied_ - 1;
+
+        bits_t least = std::numeric_limits<bits_t>::max();
+        for (auto segment: {bucket.as_spans().first, bucket.as_spans().second}) {
+            for (auto const& [key, value]: segment) {
+                bits_t bits = bits_of(key);
+                least = bits < least ? bits : least;
+            }
+        }
+        last_ = least;
+
+        // Every element shares the bits above b-1 with the new last key, so each lands in a bucket below b
+        for (auto segment: {bucket.as_spans().first, bucket.as_spans().second}) {
+            for (auto& element: segment) {
+                place(bits_of(element.first), std::move(element));
+            }
+        }
+        bucket.clear();
+    }
+
+    template<std::size_t... Idx>
+    static auto make_buckets(Allocator const& alloc, std::index_sequence<Idx...>) -> std::array<bucket_t, key_bits + 1> {
+        return {(static_cast<void>(Idx), bucket_t(alloc))...};
+    }
+
+ public:
+    /** Construct an empty heap which allocates its buckets through alloc */
+    explicit radix_heap(Allocator const& alloc = Allocator()):
+        buckets_(make_buckets(alloc, std::make_index_sequence<key_bits + 1>{})),
+        occupied_(0),
+        last_(lowest_bits()),
+        size_(0) {}
+
+    /** Returns a copy of the allocator */
+    auto get_allocator() const -> allocator_type { return buckets_[0].get_allocator(); }
+
+
+    /* ========================================================== */
+    /* ====================  ELEMENT ACCESS  ==================== */
+
+    /** Returns the element with the smallest key. Its key becomes the last key taken, the least a later push may use.
+     *  Elements with equal keys come out in no particular order. */
+    auto top() -> reference {
+        if (buckets_[0].empty()) {
+            refill();
+        }
+        return buckets_[0].front();
+    }
+
+    /** Returns the last key taken through top() or pop(), or the lowest key if none has been */
+    auto last_key() const -> key_type {
+        if constexpr (std::is_floating_point_v<Key>) {
+            constexpr bits_t sign = bits_t{1} << (key_bits - 1);
+            return std::bit_cast<Key>((last_ & sign) ? last_ ^ sign : ~last_);
+        } else {
+            return last_;
+        }
+    }
+
+
+    /* ========================================================== */
+    /* ========================  CAPACITY  ====================== */
+
+    /** Returns true if there are no elements */
+    auto empty() const -> bool { return size_ == 0; }
+
+    /** Returns number of elements */
+    auto size() const -> size_type { return size_; }
+
+
+    /* ========================================================== */
+    /* ========================  MODIFIERS  ===================== */
+
+    /** Inserts value under key. Throws std::invalid_argument if key is smaller than the last key taken. */
+    auto push(Key key, Value value) -> void {
+        bits_t bits = bits_of(key);
+        if (bits < last_) {
+            throw std::invalid_argument{"radix_heap: key is smaller than the last key taken"};
+        }
+        place(bits, value_type{key, std::move(value)});
+        size_++;
+    }
+
+    /** Removes and returns the element with the smallest key, whose key becomes the last key taken */
+    auto pop() -> value_type {
+        if (buckets_[0].empty()) {
+            refill();
+        }
+        size_--;
+        return buckets_[0].pop_front_get();
+    }
+
+    /** Removes every element and forgets the last key taken, keeping the capacity of every bucket */
+    auto clear() -> void {
+        for (auto& bucket: buckets_) {
+            bucket.clear();
+        }
+        occupied_ = 0;
+        last_     = lowest_bits();
+        size_     = 0;
+    }
+
+    auto swap(radix_heap& other) -> void {
+        for (size_type b=0; b < buckets_.size(); b++) {
+            buckets_[b].swap(other.buckets_[b]);
+        }
+        std::swap(occupied_, other.occupied_);
+        std::swap(last_,     other.last_);
+        std::swap(size_,     other.size_);
+    }
+};
+
+namespace pmr {
+
+/** radix_heap which allocates from a std::pmr::memory_resource */
+template<radix_key Key, typename Value>
+using radix_heap = dsc::radix_heap<Key, Value, std::pmr::polymorphic_allocator<std::pair<Key, Value>>>;
+
+}  // namespace pmr
+
+}  // namespace dsc
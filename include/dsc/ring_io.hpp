@@ -0,0 +1,79 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "dsc/ring_vector.hpp"
+
+namespace dsc {
+
+/** Element types whose ring_vector can be read from and written to a file descriptor as raw bytes */
+template<typename T>
+concept io_byte = sizeof(T) == 1 && std::is_trivially_copyable_v<T>;
+
+/** Returns the elements of vec as two iovecs in order, for writev. The second has length 0 when the elements do not
+ *  wrap. */
+template<io_byte T, typename Allocator>
+auto data_iovecs(ring_vector<T, Allocator> const& vec) -> std::array<iovec, 2> {
+    auto [first, second] = vec.as_spans();
+    return {{
+        {const_cast<T*>(first.data()),  first.size()},
+        {const_cast<T*>(second.data()), second.size()},
+    }};
+}
+
+/** Returns the free space after the last element of vec as two iovecs in order, for readv. The second has length 0
+ *  when the free space does not wrap. */
+template<io_byte T, typename Allocator>
+auto free_iovecs(ring_vector<T, Allocator>& vec) -> std::array<iovec, 2> {
+    auto [first, second] = vec.free_spans();
+    return {{
+        {first.data(),  first.size()},
+        {second.data(), second.size()},
+    }};
+}
+
+/** Writes the elements of vec to fd with a single writev over both segments, so wrapped data is never copied into a
+ *  linear buffer first. The bytes actually written are removed from the front of vec. Returns the result of writev:
+ *  the number of bytes written, or -1 with errno set, in which case vec is unchanged. */
+template<io_byte T, typename Allocator>
+auto write_to(ring_vector<T, Allocator>& vec, int fd) -> ssize_t {
+    if (vec.empty()) {
+        return 0;
+    }
+
+    auto    iov     = data_iovecs(vec);
+    ssize_t written = ::writev(fd, iov.data(), iov[1].iov_len == 0 ? 1 : 2);
+    if (written > 0) {
+        vec.pop_front(static_cast<std::size_t>(written));
+    }
+    return written;
+}
+
+/** Reads from fd with a single readv straight into the free space of vec, doubling its capacity first if it is
+ *  full, or reserving the minimum capacity if it has no array, as after a move. The bytes actually read are appended
+ *  to the back of vec. Returns the result of readv: the number of bytes read, 0 at end of file, or -1 with errno set,
+ *  in which case no elements are added. */
+template<io_byte T, typename Allocator>
+auto read_from(ring_vector<T, Allocator>& vec, int fd) -> ssize_t {
+    if (vec.size() == vec.capacity()) {
+        // A zero length readv would return 0, which callers take as end of file
+        vec.reserve(std::max<std::size_t>(vec.capacity() * 2, 1));
+    }
+
+    auto    iov  = free_iovecs(vec);
+    ssize_t read = ::readv(fd, iov.data(), iov[1].iov_len == 0 ? 1 : 2);
+    if (read > 0) {
+        vec.commit_back(static_cast<std::size_t>(read));
+    }
+    return read;
+}
+
+}  // namespace dsc
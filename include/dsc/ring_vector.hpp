@@ -7,14 +7,23 @@
 #include <cstddef>
 #include <cstring>
 #include <algorithm>
+#include <concepts>
+#include <execution>
+#include <functional>
 #include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
 #include <utility>
 
+#include "dsc/index_iterator.hpp"
+
 namespace dsc {
 
 template<typename T, typename Allocator = std::allocator<T>>
 class ring_vector {
-    using ui32 = size_t;
+    using ui32    = size_t;
+    using allc_tr = std::allocator_traits<Allocator>;
 
     Allocator   alloc_;
     ui32        begin_,
@@ -25,13 +34,66 @@ class ring_vector {
                 idx_mask_;
     T*          array_;
 
+    /** Returns the smallest capacity bits the vector will use. This is 2 unless Allocator requires allocations to be a
+     *  multiple of Allocator::min_capacity(), in which case it is the bits of that. */
+    static auto min_capacity_bits() -> ui32 {
+        ui32 bits = 2;
+        if constexpr (requires { { Allocator::min_capacity() } -> std::convertible_to<ui32>; }) {
+            while ((ui32{1} << bits) < Allocator::min_capacity()) {
+                bits++;
+            }
+        }
+        return bits;
+    }
+
+    /** True when Allocator can resize an allocation in place through reallocate(array, old_n, new_n), and T can be
+     *  relocated with a plain memory copy */
+    static constexpr bool can_reallocate = std::is_trivially_copyable_v<T> &&
+        requires(Allocator& alloc, T* array, ui32 n) {
+            { alloc.reallocate(array, n, n) } -> std::same_as<T*>;
+        };
+
+    /** Grows the array to 1 << new_capacity_bits through Allocator::reallocate. Elements keep their positions, so only
+     *  the part of the elements which wrapped past the end of the old array needs moving, and the shorter side of the
+     *  wrap is the one moved. */
+    auto grow_in_place(ui32 new_capacity_bits) -> void {
+        ui32 new_capacity = ui32{1} << new_capacity_bits;
+
+        array_ = alloc_.reallocate(array_, capacity_, new_capacity);
+
+        if (begin_ + size_ > capacity_) {
+            ui32 head = capacity_ - begin_;
+            ui32 tail = end_;
+            if (tail <= head) {
+                // Append wrapped elements directly after the old end of the array
+                std::memcpy(array_ + capacity_, array_, sizeof(T) * tail);
+            } else {
+                // Slide the elements at the old end of the array to the new end
+                std::memcpy(array_ + new_capacity - head, array_ + begin_, sizeof(T) * head);
+                begin_ = new_capacity - head;
+            }
+        }
+
+        capacity_      = new_capacity;
+        capacity_bits_ = new_capacity_bits;
+        idx_mask_      = new_capacity - 1;
+        end_           = (begin_ + size_) & idx_mask_;
+    }
+
     /** Resizes array to 1 << new_capacity_bits, copies elements over and deallocates previous array */
     auto resize(ui32 new_capacity_bits) -> void {
-        if (new_capacity_bits < 2) { new_capacity_bits=2; }
+        new_capacity_bits = std::max(new_capacity_bits, min_capacity_bits());
+
+        if constexpr (can_reallocate) {
+            if (new_capacity_bits > capacity_bits_ && capacity_ > 0) {
+                grow_in_place(new_capacity_bits);
+                return;
+            }
+        }
 
         ui32 new_begin    = 0;
         ui32 new_end      = size_;
-        ui32 new_capacity = 1 << new_capacity_bits;
+        ui32 new_capacity = ui32{1} << new_capacity_bits;
         ui32 new_idx_mask = new_capacity - 1;
 
         T* new_array = std::allocator_traits<Allocator>::allocate(alloc_, new_capacity);
@@ -50,7 +112,7 @@ class ring_vector {
                 // All elements are not contiguous or in order
                 if constexpr (std::is_trivially_copyable_v<T>) {
                     std::memcpy(new_array,                      array_ + begin_, sizeof(T) * (capacity_ - begin_));
-                    std::memcpy(new_array + (capacity_-begin_), array_,          sizeof(T) * size_ - (capacity_ - begin_));
+                    std::memcpy(new_array + (capacity_-begin_), array_,          sizeof(T) * (size_ - (capacity_ - begin_)));
                 } else {
                     // move construct all elements
                     for (ui32 idx = 0; idx < capacity_ - begin_; idx++) {
@@ -72,7 +134,8 @@ class ring_vector {
         idx_mask_      = new_idx_mask;
     }
 
-    /** Calls destructor on all constructed elements of array, then deallocates array */
+    /** Calls destructor on all constructed elements of array, then deallocates array, leaving the vector empty with
+     *  no array */
     auto destroy() -> void {
         // first destroy all constructed elements
         if (size_ != 0) {
@@ -95,6 +158,61 @@ class ring_vector {
         if (capacity_ > 0) {
             std::allocator_traits<Allocator>::deallocate(alloc_, array_, capacity_);
         }
+
+        begin_         = 0;
+        end_           = 0;
+        size_          = 0;
+        capacity_      = 0;
+        capacity_bits_ = 0;
+        idx_mask_      = 0;
+        array_         = nullptr;
+    }
+
+    /** Takes all attributes and the array of other, leaving other empty with no array. Any array this vector held
+     *  must already be destroyed. */
+    auto steal(ring_vector& other) -> void {
+        begin_         = std::exchange(other.begin_, 0);
+        end_           = std::exchange(other.end_, 0);
+        size_          = std::exchange(other.size_, 0);
+        capacity_      = std::exchange(other.capacity_, 0);
+        capacity_bits_ = std::exchange(other.capacity_bits_, 0);
+        idx_mask_      = std::exchange(other.idx_mask_, 0);
+        array_         = std::exchange(other.array_, nullptr);
+    }
+
+    /** Allocates an array of other's capacity through this vector's allocator and copies each element of other into
+     *  the same slot, or moves them if other is an rvalue. Only called from constructors. Nothing is stored until
+     *  every element is built, and if an allocation or element constructor throws, everything built is released. */
+    template<typename Other>
+    auto construct_from(Other&& other) -> void {
+        T*   new_array = other.capacity_ > 0 ? allc_tr::allocate(alloc_, other.capacity_) : nullptr;
+        ui32 built     = 0;
+        try {
+            for (; built < other.size_; built++) {
+                ui32 slot = (other.begin_+built) & other.idx_mask_;
+                if constexpr (std::is_rvalue_reference_v<Other&&>) {
+                    allc_tr::construct(alloc_, new_array+slot, std::move(other.array_[slot]));
+                } else {
+                    allc_tr::construct(alloc_, new_array+slot, other.array_[slot]);
+                }
+            }
+        } catch (...) {
+            for (ui32 idx=0; idx < built; idx++) {
+                allc_tr::destroy(alloc_, new_array + ((other.begin_+idx) & other.idx_mask_));
+            }
+            if (new_array) {
+                allc_tr::deallocate(alloc_, new_array, other.capacity_);
+            }
+            throw;
+        }
+
+        begin_         = other.begin_;
+        end_           = other.end_;
+        size_          = other.size_;
+        capacity_      = other.capacity_;
+        capacity_bits_ = other.capacity_bits_;
+        idx_mask_      = other.idx_mask_;
+        array_         = new_array;
     }
 
  public:
@@ -107,76 +225,51 @@ class ring_vector {
     using pointer           = value_type*;
     using const_pointer     = const value_type*;
 
-    /** Allocates an empty ring vector. Reserves 4 spaces by default. */
-    ring_vector():  begin_(0),
-                    end_(0),
-                    size_(0),
-                    capacity_(4),
-                    capacity_bits_(2),
-                    idx_mask_((1<<2)-1) {
+    /** Allocates an empty ring vector. Reserves 4 spaces by default, or the minimum capacity of the allocator. */
+    ring_vector(): ring_vector(0, Allocator()) {}
 
-        array_ = std::allocator_traits<Allocator>::allocate(alloc_, capacity_);
-    }
+    /** Allocates an empty ring vector which allocates all of its memory through alloc */
+    explicit ring_vector(Allocator const& alloc): ring_vector(0, alloc) {}
 
     /** Allocates an empty ring vector with reserve_space reserved. */
-    explicit ring_vector(ui32 reserve_space):  begin_(0), end_(0), size_(0) {
-        capacity_bits_ = 2;
-        while ((1<<capacity_bits_) < reserve_space) {
+    explicit ring_vector(ui32 reserve_space, Allocator const& alloc = Allocator()):  alloc_(alloc),
+                                                                                   begin_(0),
+                                                                                   end_(0),
+                                                                                   size_(0) {
+        capacity_bits_ = min_capacity_bits();
+        while ((ui32{1} << capacity_bits_) < reserve_space) {
             capacity_bits_++;
         }
-        capacity_ = 1 << capacity_bits_;
+        capacity_ = ui32{1} << capacity_bits_;
         idx_mask_ = capacity_ - 1;
 
-        array_ = std::allocator_traits<Allocator>::allocate(alloc_, capacity_);
+        array_ = allc_tr::allocate(alloc_, capacity_);
     }
 
     /** Copy constructor which creates a ring vector with all attributes equal to another vector
-     *  and copies all elements over with T's copy constructor */
-    ring_vector(ring_vector const& other): begin_(other.begin_),
-                                        end_(other.end_),
-                                        size_(other.size_),
-                                        capacity_(other.capacity_),
-                                        capacity_bits_(other.capacity_bits_),
-                                        idx_mask_(other.idx_mask_) {
+     *  and copies all elements over with T's copy constructor. The allocator is chosen by
+     *  select_on_container_copy_construction. */
+    ring_vector(ring_vector const& other): ring_vector(other, allc_tr::select_on_container_copy_construction(other.alloc_)) {}
 
-        array_ = std::allocator_traits<Allocator>::allocate(alloc_, capacity_);
-
-        if (size_ != 0) {
-            if (begin_ < end_) {
-                // All elements are contiguous and in order
-                for (ui32 idx=begin_; idx < begin_+size_; idx++) {
-                    std::allocator_traits<Allocator>::construct(alloc_, array_+idx, other.array_[idx]);
-                }
-            } else {
-                // All elements are not contiguous or in order
-                for (ui32 idx=begin_; idx < capacity_; idx++) {
-                    std::allocator_traits<Allocator>::construct(alloc_, array_+idx, other.array_[idx]);
-                }
-                for (ui32 idx=0; idx < end_; idx++) {
-                    std::allocator_traits<Allocator>::construct(alloc_, array_+idx, other.array_[idx]);
-                }
-            }
-        }
+    /** Copy constructor which allocates through alloc */
+    ring_vector(ring_vector const& other, Allocator const& alloc): alloc_(alloc) {
+        construct_from(other);
     }
 
-    /** Move constructor which creates a ring vector with all attributes equal to another vector
+    /** Move constructor which creates a ring vector with all attributes and the allocator of another vector
      *  and empties other ring vector */
-    ring_vector(ring_vector&& other): begin_(other.begin_),
-                                    end_(other.end_),
-                                    size_(other.size_),
-                                    capacity_(other.capacity_),
-                                    capacity_bits_(other.capacity_bits_),
-                                    idx_mask_(other.idx_mask_) {
-
-        array_ = other.array_;
+    ring_vector(ring_vector&& other) noexcept: alloc_(std::move(other.alloc_)) {
+        steal(other);
+    }
 
-        other.begin_           = 0;
-        other.end_             = 0;
-        other.size_            = 0;
-        other.capacity_        = 0;
-        other.capacity_bits_   = 0;
-        other.idx_mask_        = 0;
-        other.array_           = nullptr;
+    /** Move constructor which allocates through alloc. Takes other's array if alloc compares equal to other's
+     *  allocator, otherwise moves each element into a new array. */
+    ring_vector(ring_vector&& other, Allocator const& alloc): alloc_(alloc) {
+        if (alloc_ == other.alloc_) {
+            steal(other);
+        } else {
+            construct_from(std::move(other));
+        }
     }
 
     ~ring_vector() {
@@ -203,101 +296,109 @@ class ring_vector {
     auto front() const -> const_reference   { return array_[begin_]; }
 
     /** Returns reference to last element in vector */
-    auto back() -> reference               { return array_[(begin_+size_) & idx_mask_]; }
-    /** Returns const reference to first element in vector */
-    auto back() const -> const_reference   { return array_[(begin_+size_) & idx_mask_]; }
+    auto back() -> reference               { return array_[(begin_+size_-1) & idx_mask_]; }
+    /** Returns const reference to last element in vector */
+    auto back() const -> const_reference   { return array_[(begin_+size_-1) & idx_mask_]; }
 
 
     /* ========================================================== */
     /* =======================  ITERATORS  ====================== */
 
-    class iterator {
-     private:
-        ring_vector<T>& m_array;
-        ui32 m_idx;
-
-     public:
-        using difference_type   = ui32;
-        using value_type        = T;
-        using pointer           = value_type*;
-        using reference         = value_type&;
-        using iterator_category = std::forward_iterator_tag;
-
-        iterator(ring_vector<T>& array, ui32 idx = 0) : m_array(array), m_idx(idx) {}
-
-        auto operator++()    -> iterator& { m_idx++; return *this; }
-        auto operator++(int) -> iterator  { iterator retval = *this; ++(*this); return retval; }
-        auto operator+=(int offset) -> iterator  {
-            m_idx = std::min(m_idx+offset, m_array.size());
-            return *this;
-        }
-        auto operator+(int offset) -> iterator  {
-            iterator retval = *this;
-            return retval += offset;
-        }
+    using iterator       = index_iterator<ring_vector, T>;
+    using const_iterator = index_iterator<ring_vector, T const>;
 
-        auto operator--()    -> iterator& { m_idx--; return *this; }
-        auto operator--(int) -> iterator  { iterator retval = *this; --(*this); return retval; }
-        auto operator-=(int offset) -> iterator  {
-            m_idx = std::max(static_cast<int_fast64_t>(m_idx)-offset, int_fast64_t{0});
-            return *this;
-        }
-        auto operator-(int offset) -> iterator  {
-            iterator retval = *this;
-            return retval -= offset;
-        }
+    /** Returns random access iterator on this vector starting at front */
+    auto begin() -> iterator { return {*this, 0}; }
+    /** Returns end position of random access iterator */
+    auto end()   -> iterator { return {*this, size_}; }
 
-        auto operator==(iterator other) const -> bool { return m_idx == other.m_idx; }
-        auto operator!=(iterator other) const -> bool { return !(*this == other); }
+    /** Returns const random access iterator on this vector starting at front */
+    auto begin() const -> const_iterator { return {*this, 0}; }
+    /** Returns end position of const random access iterator */
+    auto end()   const -> const_iterator { return {*this, size_}; }
 
-        auto operator> (iterator other) const -> bool { return m_idx > other.m_idx; }
-        auto operator>=(iterator other) const -> bool { return m_idx >= other.m_idx; }
-        auto operator< (iterator other) const -> bool { return m_idx < other.m_idx; }
-        auto operator<=(iterator other) const -> bool { return m_idx <= other.m_idx; }
+    /** Returns const random access iterator on this vector starting at front */
+    auto cbegin() const -> const_iterator { return {*this, 0}; }
+    /** Returns end position of const random access iterator */
+    auto cend()   const -> const_iterator { return {*this, size_}; }
 
-        auto operator* () -> reference { return  m_array[m_idx]; }
-        auto operator->() -> pointer   { return &m_array[m_idx]; }
-    };
 
-    class const_iterator {
-     private:
-        const ring_vector<T>& m_array;
-        ui32 m_idx;
+    /* ========================================================== */
+    /* =======================  SEGMENTS  ======================= */
 
-     public:
-        using difference_type   = ui32;
-        using value_type        = T;
-        using pointer           = value_type const *;
-        using reference         = const value_type&;
-        using iterator_category = std::forward_iterator_tag;
+    /** Returns the elements as two contiguous spans in order. The second span is empty when the elements do not wrap
+     *  around the end of the array. */
+    auto as_spans() -> std::pair<std::span<T>, std::span<T>> {
+        if (begin_ + size_ <= capacity_) {
+            return {{array_ + begin_, size_}, {}};
+        }
+        return {{array_ + begin_, capacity_ - begin_}, {array_, end_}};
+    }
 
-        const_iterator(const ring_vector<T>& array, ui32 idx = 0) : m_array(array), m_idx(idx) {}
+    /** Returns the elements as two contiguous const spans in order. The second span is empty when the elements do not
+     *  wrap around the end of the array. */
+    auto as_spans() const -> std::pair<std::span<T const>, std::span<T const>> {
+        if (begin_ + size_ <= capacity_) {
+            return {{array_ + begin_, size_}, {}};
+        }
+        return {{array_ + begin_, capacity_ - begin_}, {array_, end_}};
+    }
 
-        auto operator++()    -> iterator& { m_idx++; return *this; }
-        auto operator++(int) -> iterator  { iterator retval = *this; ++(*this); return retval; }
+    /** Returns the unused slots after the last element as two contiguous spans, in the order elements pushed to the
+     *  back would fill them. The second span is empty when the free space does not wrap. Data written here becomes
+     *  part of the vector through commit_back(). */
+    auto free_spans() -> std::pair<std::span<T>, std::span<T>> {
+        if (size_ == capacity_) {
+            return {};
+        }
+        if (end_ < begin_) {
+            return {{array_ + end_, begin_ - end_}, {}};
+        }
+        return {{array_ + end_, capacity_ - end_}, {array_, begin_}};
+    }
 
-        auto operator==(iterator const& other) const -> bool { return m_idx == other.m_idx; }
-        auto operator!=(iterator const& other) const -> bool { return !(*this == other); }
+    /** Returns all elements as a single contiguous span. Only available with mirrored storage, where the array is
+     *  mapped twice back to back, so elements which wrap past the end of the array continue in the mirror. */
+    auto contiguous_view() -> std::span<T> requires Allocator::mirrored {
+        return {array_ + begin_, size_};
+    }
 
-        auto operator* () -> reference { return  m_array[m_idx]; }
-        auto operator->() -> pointer   { return &m_array[m_idx]; }
-    };
+    /** Returns all elements as a single contiguous const span. Only available with mirrored storage. */
+    auto contiguous_view() const -> std::span<T const> requires Allocator::mirrored {
+        return {array_ + begin_, size_};
+    }
 
-    /** Returns forward iterator on this vector starting at front */
-    auto begin() -> iterator { return {*this, 0}; }
-    /** Returns end position of forward iterator */
-    auto end()   -> iterator { return {*this, size_}; }
+    /** Calls f on each non-empty contiguous segment in order. If f returns a bool, stops as soon as f returns false.
+     *  Returns false if iteration was stopped early. */
+    template<typename F>
+    auto for_each_segment(F&& f) -> bool {
+        auto [first, second] = as_spans();
+        return visit_segment(f, first) && visit_segment(f, second);
+    }
 
-    /** Returns const forward iterator on this vector starting at front */
-    auto begin() const -> const_iterator { return {*this, 0}; }
-    /** Returns end position of const forward iterator */
-    auto end()   const -> const_iterator { return {*this, size_}; }
+    /** Calls f on each non-empty contiguous const segment in order. If f returns a bool, stops as soon as f returns
+     *  false. Returns false if iteration was stopped early. */
+    template<typename F>
+    auto for_each_segment(F&& f) const -> bool {
+        auto [first, second] = as_spans();
+        return visit_segment(f, first) && visit_segment(f, second);
+    }
 
-    /** Returns const forward iterator on this vector starting at front */
-    auto cbegin() const -> const_iterator { return {*this, 0}; }
-    /** Returns end position of const forward iterator */
-    auto cend()   const -> const_iterator { return {*this, size_}; }
+ private:
+    template<typename F, typename Span>
+    static auto visit_segment(F& f, Span segment) -> bool {
+        if (segment.empty()) {
+            return true;
+        }
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, Span>, bool>) {
+            return f(segment);
+        } else {
+            f(segment);
+            return true;
+        }
+    }
 
+ public:
 
     /* ========================================================== */
     /* ========================  CAPACITY  ====================== */
@@ -319,8 +420,8 @@ class ring_vector {
             return;
         }
 
-        ui32 new_capacity_bits = 2;
-        while ((1<<new_capacity_bits) < new_capacity) {
+        ui32 new_capacity_bits = min_capacity_bits();
+        while ((ui32{1} << new_capacity_bits) < new_capacity) {
             new_capacity_bits++;
         }
 
@@ -329,9 +430,10 @@ class ring_vector {
         }
     }
 
-    /** Attempts to return memory to the system by shrinking array capacity, to a minimum of 4. Equivalent to calling reserve(size) */
+    /** Attempts to return memory to the system by shrinking array capacity, to a minimum of 4 or the minimum capacity
+     *  of the allocator. Equivalent to calling reserve(size) */
     auto shrink_to_fit() -> void {
-        reserve(std::max<ui32>(size_, 4));
+        reserve(std::max<ui32>(size_, ui32{1} << min_capacity_bits()));
     }
 
 
@@ -406,6 +508,54 @@ class ring_vector {
         size_++;
     }
 
+    /** Place one element at the end of the vector without ever growing it. If the vector is full, the oldest element
+     *  at the front is overwritten in place and the front advances, so capacity acts as a bound on the number of
+     *  elements kept. The bound is capacity(), not the number passed to the reserving constructor: capacity is rounded
+     *  up to a power of 2 with a minimum of 4, or the minimum capacity of the allocator, so ring_vector{1000} keeps the
+     *  last 1024 elements. A vector with no array, such as a moved-from one, first reserves that minimum. */
+    auto push_back_overwrite(T value) -> void {
+        push_back_overwrite(std::move(value), [](T&) {});
+    }
+
+    /** Place one element at the end of the vector without ever growing it. If the vector is full, on_evict is called
+     *  with the oldest element, which is then overwritten in place by value. on_evict may move from the element. */
+    template<typename F>
+    auto push_back_overwrite(T value, F&& on_evict) -> void {
+        if (capacity_ == 0) {
+            resize(min_capacity_bits());
+        }
+        if (size_ < capacity_) {
+            std::allocator_traits<Allocator>::construct(alloc_, array_+end_, std::move(value));
+            end_ = (end_+1) & idx_mask_;
+            size_++;
+            return;
+        }
+
+        on_evict(array_[begin_]);
+        array_[begin_] = std::move(value);
+        begin_ = (begin_+1) & idx_mask_;
+        end_   = begin_;
+    }
+
+    /** Constructs one element at the end of the vector without ever growing it. If the vector is full, the new element
+     *  is constructed as a temporary and move assigned over the oldest element, so a throwing constructor leaves the
+     *  vector unchanged. Bounded by capacity() like push_back_overwrite. */
+    template<typename... Args>
+    auto emplace_back_overwrite(Args&&... args) -> void {
+        if (capacity_ == 0) {
+            resize(min_capacity_bits());
+        }
+        if (size_ < capacity_) {
+            emplace_back(std::forward<Args>(args)...);
+            return;
+        }
+
+        T value(std::forward<Args>(args)...);
+        array_[begin_] = std::move(value);
+        begin_ = (begin_+1) & idx_mask_;
+        end_   = begin_;
+    }
+
     /** Remove one element from the end of the vector */
     auto pop_back() -> void {
         end_ = (end_-1) & idx_mask_;
@@ -430,6 +580,24 @@ class ring_vector {
         size_--;
     }
 
+    /** Remove count elements from the beginning of the vector */
+    auto pop_front(ui32 count) -> void {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (ui32 idx=0; idx < count; idx++) {
+                std::allocator_traits<Allocator>::destroy(alloc_, array_ + ((begin_+idx) & idx_mask_));
+            }
+        }
+        begin_ = (begin_+count) & idx_mask_;
+        size_ -= count;
+    }
+
+    /** Appends the first count free slots, already filled through free_spans(), as elements at the end of the vector.
+     *  count must not exceed capacity() - size(). */
+    auto commit_back(ui32 count) -> void requires std::is_trivially_copyable_v<T> {
+        end_ = (end_+count) & idx_mask_;
+        size_ += count;
+    }
+
     /** Remove one element from the begninning of the vector and return the element */
     auto pop_front_get() -> T {
         T temp = std::move(array_[begin_]);
@@ -510,64 +678,84 @@ class ring_vector {
     /* ========================================================== */
     /* =======================  OPERATIONS  ===================== */
 
+    /** Replaces the contents with a copy of other. The allocator is replaced by other's only if
+     *  propagate_on_container_copy_assignment is set. The copy is built before the current array is released, so if
+     *  it throws this vector is unchanged. */
     auto operator=(const ring_vector& other) -> ring_vector& {
+        if (this == &other) {
+            return *this;
+        }
 
+        auto copy = ring_vector(other, allc_tr::propagate_on_container_copy_assignment::value ? other.alloc_ : alloc_);
         destroy();
+        if constexpr (allc_tr::propagate_on_container_copy_assignment::value) {
+            alloc_ = other.alloc_;
+        }
+        steal(copy);
 
-        begin_         = other.begin_;
-        end_           = other.end_;
-        size_          = other.size_;
-        capacity_      = other.capacity_;
-        capacity_bits_ = other.capacity_bits_;
-        idx_mask_      = other.idx_mask_;
+        return *this;
+    }
 
-        array_ = std::allocator_traits<Allocator>::allocate(alloc_, capacity_);
+    /** Replaces the contents with those of other, leaving other empty. other's array is taken over when the allocator
+     *  propagates on move assignment or the allocators compare equal, otherwise each element is moved into a new array
+     *  from this vector's allocator. */
+    auto operator=(ring_vector&& other) -> ring_vector& {
+        if (this == &other) {
+            return *this;
+        }
 
-        if (size_ != 0) {
-            if (begin_ < end_) {
-                // All elements are contiguous and in order
-                for (ui32 idx=begin_; idx < begin_+size_; idx++) {
-                    std::allocator_traits<Allocator>::construct(alloc_, array_+idx, other.array_[idx]);
-                }
+        if constexpr (allc_tr::propagate_on_container_move_assignment::value) {
+            destroy();
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                destroy();
+                steal(other);
             } else {
-                // All elements are not contiguous or in order
-                for (ui32 idx=begin_; idx < capacity_; idx++) {
-                    std::allocator_traits<Allocator>::construct(alloc_, array_+idx, other.array_[idx]);
-                }
-                for (ui32 idx=0; idx < end_; idx++) {
-                    std::allocator_traits<Allocator>::construct(alloc_, array_+idx, other.array_[idx]);
-                }
+                // Move the elements into a new array before releasing the current one, so a throw leaves this
+                // vector unchanged
+                auto moved = ring_vector(std::move(other), alloc_);
+                other.clear();
+                destroy();
+                steal(moved);
             }
         }
 
         return *this;
     }
 
-    auto operator=(ring_vector&& other) -> ring_vector& {
-
-        destroy();
-
-        begin_         = other.begin_;
-        end_           = other.end_;
-        size_          = other.size_;
-        capacity_      = other.capacity_;
-        capacity_bits_ = other.capacity_bits_;
-        idx_mask_      = other.idx_mask_;
-
-        array_ = other.array_;
-
-        other.begin_           = 0;
-        other.end_             = 0;
-        other.size_            = 0;
-        other.capacity_        = 0;
-        other.capacity_bits_   = 0;
-        other.idx_mask_        = 0;
-        other.array_           = nullptr;
+    /** Sorts the vector in place. Each contiguous segment is sorted directly on the backing array and the two sorted
+     *  segments are merged once afterwards, so the wrap point costs a single linear merge. */
+    template<typename Compare = std::less<>>
+    requires (!std::is_execution_policy_v<std::remove_cvref_t<Compare>>)
+    auto sort(Compare comp = {}) -> void {
+        auto [first, second] = as_spans();
+        std::sort(first.data(), first.data() + first.size(), comp);
+        if (!second.empty()) {
+            std::sort(second.data(), second.data() + second.size(), comp);
+            std::inplace_merge(begin(), begin() + first.size(), end(), comp);
+        }
+    }
 
-        return *this;
+    /** Sorts the vector in place using the given execution policy for both the segment sorts and the final merge. */
+    template<typename ExecutionPolicy, typename Compare = std::less<>>
+    requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    auto sort(ExecutionPolicy&& policy, Compare comp = {}) -> void {
+        auto [first, second] = as_spans();
+        std::sort(policy, first.data(), first.data() + first.size(), comp);
+        if (!second.empty()) {
+            std::sort(policy, second.data(), second.data() + second.size(), comp);
+            std::inplace_merge(policy, begin(), begin() + first.size(), end(), comp);
+        }
     }
 
+    /** Swaps contents with other. Allocators are swapped only if propagate_on_container_swap is set, otherwise
+     *  they must compare equal. */
     auto swap(ring_vector& other) -> void {
+        if constexpr (allc_tr::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
         std::swap(array_,          other.array_);
         std::swap(begin_,          other.begin_);
         std::swap(end_,            other.end_);
@@ -576,6 +764,17 @@ class ring_vector {
         std::swap(capacity_bits_,  other.capacity_bits_);
         std::swap(idx_mask_,       other.idx_mask_);
     }
+
+    /** Returns a copy of the allocator */
+    auto get_allocator() const -> allocator_type { return alloc_; }
 };
 
+namespace pmr {
+
+/** ring_vector which allocates from a std::pmr::memory_resource */
+template<typename T>
+using ring_vector = dsc::ring_vector<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }  // namespace dsc
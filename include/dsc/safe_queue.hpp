@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include <memory_resource>
 #include <optional>
 #include <utility>
 #include <mutex>
@@ -10,17 +12,23 @@
 namespace dsc{
 
 /** Thread-safe storage object which can store a single item through get(), which can be retrieved with put(). */
-template<typename T>
+template<typename T, typename Allocator = std::allocator<T>>
 class safe_queue {
-    ring_vector<T>          queue_;
-    std::mutex              mutex_;
-    std::condition_variable get_cv_;
+    ring_vector<T, Allocator>   queue_;
+    std::mutex                  mutex_;
+    std::condition_variable     get_cv_;
 
  public:
+    using allocator_type = Allocator;
+
     /** Constructs an empty box. */
     safe_queue():   queue_(),
                     mutex_() {}
 
+    /** Constructs an empty queue which allocates its storage through alloc. */
+    explicit safe_queue(Allocator const& alloc):    queue_(alloc),
+                                                    mutex_() {}
+
     /** Retrieves item from box. If there is no item, blocks until an item is placed inside. */
     auto get() -> T {
         auto lock = std::unique_lock{mutex_};
@@ -52,6 +60,17 @@ class safe_queue {
         queue_.push_back(std::move(new_data));
         get_cv_.notify_all();
     }
+
+    /** Returns a copy of the allocator */
+    auto get_allocator() const -> allocator_type { return queue_.get_allocator(); }
 };
 
+namespace pmr {
+
+/** safe_queue which allocates from a std::pmr::memory_resource */
+template<typename T>
+using safe_queue = dsc::safe_queue<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }
\ No newline at end of file
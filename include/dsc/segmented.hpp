@@ -0,0 +1,207 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <type_traits>
+
+namespace dsc {
+
+/** A segmented range stores its elements as an ordered sequence of contiguous segments. for_each_segment(f) calls f
+ *  on each non-empty segment as a std::span, stopping early if f returns false. Algorithms written against this
+ *  protocol run a plain pointer loop per segment, which the compiler can unroll and vectorize, instead of paying for
+ *  an index mask on every element. */
+template<typename R>
+concept segmented_range = requires(R const& r) {
+    { r.size() } -> std::convertible_to<std::size_t>;
+    r.for_each_segment([](auto) { return true; });
+};
+
+/** Two contiguous spans viewed in order as one segmented range, such as a single column of a ring buffer. The spans
+ *  are public so the pair can be unpacked with structured bindings. */
+template<typename T>
+struct segment_pair {
+    std::span<T> first;
+    std::span<T> second;
+
+    /** Returns the total number of elements in both spans */
+    auto size() const -> std::size_t { return first.size() + second.size(); }
+
+    /** Returns reference to an element at the given position */
+    auto operator[](std::size_t pos) const -> T& {
+        return pos < first.size() ? first[pos] : second[pos - first.size()];
+    }
+
+    /** Calls f on each non-empty span in order. If f returns a bool, stops as soon as f returns false. Returns false
+     *  if iteration was stopped early. */
+    template<typename F>
+    auto for_each_segment(F&& f) const -> bool {
+        for (auto segment: {first, second}) {
+            if (segment.empty()) {
+                continue;
+            }
+            if constexpr (std::is_same_v<std::invoke_result_t<F&, std::span<T>>, bool>) {
+                if (!f(segment)) {
+                    return false;
+                }
+            } else {
+                f(segment);
+            }
+        }
+        return true;
+    }
+};
+
+/** Returns the position of the first element equal to value, or size() if there is none */
+template<segmented_range R, typename U>
+auto find(R const& range, U const& value) -> std::size_t {
+    auto pos = std::size_t{0};
+    range.for_each_segment([&](auto segment) {
+        auto const* data = segment.data();
+        auto const  len  = segment.size();
+        for (std::size_t idx=0; idx < len; idx++) {
+            if (data[idx] == value) {
+                pos += idx;
+                return false;
+            }
+        }
+        pos += len;
+        return true;
+    });
+    return pos;
+}
+
+/** Returns the number of elements equal to value */
+template<segmented_range R, typename U>
+auto count(R const& range, U const& value) -> std::size_t {
+    auto total = std::size_t{0};
+    range.for_each_segment([&](auto segment) {
+        auto const* data = segment.data();
+        auto const  len  = segment.size();
+        auto        n    = std::size_t{0};
+        // Branchless so the loop vectorizes into a compare and add
+        for (std::size_t idx=0; idx < len; idx++) {
+            n += (data[idx] == value);
+        }
+        total += n;
+    });
+    return total;
+}
+
+/** Returns init plus the sum of all elements */
+template<segmented_range R, typename U>
+auto accumulate(R const& range, U init) -> U {
+    range.for_each_segment([&](auto segment) {
+        auto const* data = segment.data();
+        auto const  len  = segment.size();
+        if constexpr (std::is_arithmetic_v<U>) {
+            // Independent partial sums break the dependency chain on init, letting floating point sums pipeline and
+            // integer sums vectorize. This may round differently than a strict left to right sum of floats.
+            U      partial[4] = {};
+            auto   idx        = std::size_t{0};
+            for (; idx + 4 <= len; idx += 4) {
+                partial[0] += data[idx];
+                partial[1] += data[idx+1];
+                partial[2] += data[idx+2];
+                partial[3] += data[idx+3];
+            }
+            for (; idx < len; idx++) {
+                partial[0] += data[idx];
+            }
+            init += (partial[0] + partial[1]) + (partial[2] + partial[3]);
+        } else {
+            for (std::size_t idx=0; idx < len; idx++) {
+                init = std::move(init) + data[idx];
+            }
+        }
+    });
+    return init;
+}
+
+/** Returns the position of the first smallest element, or 0 if the range is empty */
+template<segmented_range R>
+auto min_element(R const& range) -> std::size_t {
+    if (range.size() == 0) {
+        return 0;
+    }
+
+    using value_t = std::remove_cvref_t<decltype(range[0])>;
+    if constexpr (std::is_arithmetic_v<value_t>) {
+        // A value-only reduction vectorizes, where tracking the index as well does not. Find the position afterwards.
+        auto best = range[0];
+        range.for_each_segment([&](auto segment) {
+            auto const* data = segment.data();
+            auto const  len  = segment.size();
+            auto        m    = best;
+            for (std::size_t idx=0; idx < len; idx++) {
+                m = data[idx] < m ? data[idx] : m;
+            }
+            best = m;
+        });
+        // Comparisons with NaN are false, so a NaN first element is never replaced and find cannot match it.
+        // std::min_element and std::max_element return the first element in that case too.
+        if (best != best) {
+            return 0;
+        }
+        return find(range, best);
+    } else {
+        auto best = std::size_t{0};
+        auto pos  = std::size_t{0};
+        range.for_each_segment([&](auto segment) {
+            for (std::size_t idx=0; idx < segment.size(); idx++) {
+                if (segment[idx] < range[best]) {
+                    best = pos + idx;
+                }
+            }
+            pos += segment.size();
+        });
+        return best;
+    }
+}
+
+/** Returns the position of the first largest element, or 0 if the range is empty */
+template<segmented_range R>
+auto max_element(R const& range) -> std::size_t {
+    if (range.size() == 0) {
+        return 0;
+    }
+
+    using value_t = std::remove_cvref_t<decltype(range[0])>;
+    if constexpr (std::is_arithmetic_v<value_t>) {
+        // A value-only reduction vectorizes, where tracking the index as well does not. Find the position afterwards.
+        auto best = range[0];
+        range.for_each_segment([&](auto segment) {
+            auto const* data = segment.data();
+            auto const  len  = segment.size();
+            auto        m    = best;
+            for (std::size_t idx=0; idx < len; idx++) {
+                m = m < data[idx] ? data[idx] : m;
+            }
+            best = m;
+        });
+        // Comparisons with NaN are false, so a NaN first element is never replaced and find cannot match it.
+        // std::min_element and std::max_element return the first element in that case too.
+        if (best != best) {
+            return 0;
+        }
+        return find(range, best);
+    } else {
+        auto best = std::size_t{0};
+        auto pos  = std::size_t{0};
+        range.for_each_segment([&](auto segment) {
+            for (std::size_t idx=0; idx < segment.size(); idx++) {
+                if (range[best] < segment[idx]) {
+                    best = pos + idx;
+                }
+            }
+            pos += segment.size();
+        });
+        return best;
+    }
+}
+
+}  // namespace dsc
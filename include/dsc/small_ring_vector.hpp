@@ -0,0 +1,363 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "dsc/index_iterator.hpp"
+
+namespace dsc {
+
+/** Ring vector which keeps up to N elements inside the object itself and only allocates from Allocator once it grows
+ *  past N. Short lived or usually small queues then never touch the heap. N must be a power of 2. Moving a
+ *  small_ring_vector whose elements are inline moves each element rather than stealing a pointer. */
+template<typename T, std::size_t N, typename Allocator = std::allocator<T>>
+class small_ring_vector {
+    static_assert(std::has_single_bit(N), "N must be a power of 2");
+
+    using ui32    = std::size_t;
+    using allc_tr = std::allocator_traits<Allocator>;
+
+    Allocator   alloc_;
+    ui32        begin_,
+                size_,
+                capacity_,
+                idx_mask_;
+    T*          array_;
+    alignas(T) std::byte inline_[N * sizeof(T)];
+
+    auto inline_array() -> T* { return reinterpret_cast<T*>(inline_); }
+
+    /** Returns true if elements are stored inline */
+    auto is_inline() const -> bool { return array_ == reinterpret_cast<T const*>(inline_); }
+
+    /** Moves all elements in order into a heap array of new_capacity, releasing the previous array */
+    auto resize(ui32 new_capacity) -> void {
+        T* new_array = allc_tr::allocate(alloc_, new_capacity);
+        for (ui32 idx=0; idx < size_; idx++) {
+            T* src = array_ + ((begin_ + idx) & idx_mask_);
+            allc_tr::construct(alloc_, new_array + idx, std::move(*src));
+            allc_tr::destroy(alloc_, src);
+        }
+        if (!is_inline()) {
+            allc_tr::deallocate(alloc_, array_, capacity_);
+        }
+
+        array_    = new_array;
+        begin_    = 0;
+        capacity_ = new_capacity;
+        idx_mask_ = new_capacity - 1;
+    }
+
+    /** Resets to empty inline storage without destroying or deallocating anything */
+    auto reset() -> void {
+        begin_    = 0;
+        size_     = 0;
+        capacity_ = N;
+        idx_mask_ = N - 1;
+        array_    = inline_array();
+    }
+
+    /** Destroys all elements and releases a heap array, returning to empty inline storage */
+    auto destroy() -> void {
+        clear();
+        if (!is_inline()) {
+            allc_tr::deallocate(alloc_, array_, capacity_);
+            reset();
+        }
+    }
+
+    /** Takes the elements of other, leaving it empty and inline. Steals the heap array if other has spilled, which
+     *  this vector's allocator must be able to deallocate, otherwise moves each inline element. This vector must be
+     *  empty and inline. */
+    auto take(small_ring_vector& other) -> void {
+        if (other.is_inline()) {
+            for (ui32 idx=0; idx < other.size_; idx++) {
+                push_back(std::move(other[idx]));
+            }
+            other.clear();
+        } else {
+            begin_    = other.begin_;
+            size_     = other.size_;
+            capacity_ = other.capacity_;
+            idx_mask_ = other.idx_mask_;
+            array_    = other.array_;
+            other.reset();
+        }
+    }
+
+    /** Copies each element of other, or moves them if other is an rvalue, allocating through this vector's allocator
+     *  if they do not fit inline. This vector must be empty and inline. */
+    template<typename Other>
+    auto construct_from(Other&& other) -> void {
+        reserve(other.size_);
+        for (ui32 idx=0; idx < other.size_; idx++) {
+            if constexpr (std::is_rvalue_reference_v<Other&&>) {
+                push_back(std::move(other[idx]));
+            } else {
+                push_back(other[idx]);
+            }
+        }
+    }
+
+ public:
+    using value_type        = T;
+    using allocator_type    = Allocator;
+    using size_type         = ui32;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+    using pointer           = value_type*;
+    using const_pointer     = const value_type*;
+
+    /** Constructs an empty vector using inline storage. Does not allocate. */
+    small_ring_vector(): small_ring_vector(Allocator()) {}
+
+    /** Constructs an empty vector using inline storage, which allocates through alloc once it spills */
+    explicit small_ring_vector(Allocator const& alloc): alloc_(alloc) {
+        reset();
+    }
+
+    /** Copy constructor which copies all elements over with T's copy constructor. The allocator is chosen by
+     *  select_on_container_copy_construction. */
+    small_ring_vector(small_ring_vector const& other):
+        small_ring_vector(other, allc_tr::select_on_container_copy_construction(other.alloc_)) {}
+
+    /** Copy constructor which allocates through alloc */
+    small_ring_vector(small_ring_vector const& other, Allocator const& alloc): small_ring_vector(alloc) {
+        construct_from(other);
+    }
+
+    /** Move constructor which takes the allocator of other. Steals the heap array if other has spilled, otherwise
+     *  moves each inline element. */
+    small_ring_vector(small_ring_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>):
+        alloc_(std::move(other.alloc_)) {
+        reset();
+        take(other);
+    }
+
+    /** Move constructor which allocates through alloc. Steals the heap array of other only if alloc compares equal
+     *  to other's allocator. */
+    small_ring_vector(small_ring_vector&& other, Allocator const& alloc): small_ring_vector(alloc) {
+        if (alloc_ == other.alloc_) {
+            take(other);
+        } else {
+            construct_from(std::move(other));
+            other.clear();
+        }
+    }
+
+    ~small_ring_vector() {
+        destroy();
+    }
+
+    /** Replaces the contents with a copy of other. The allocator is replaced by other's only if
+     *  propagate_on_container_copy_assignment is set. */
+    auto operator=(small_ring_vector const& other) -> small_ring_vector& {
+        if (this == &other) {
+            return *this;
+        }
+
+        destroy();
+        if constexpr (allc_tr::propagate_on_container_copy_assignment::value) {
+            alloc_ = other.alloc_;
+        }
+        construct_from(other);
+
+        return *this;
+    }
+
+    /** Replaces the contents with those of other, leaving other empty. other's heap array is taken over when the
+     *  allocator propagates on move assignment or the allocators compare equal, otherwise each element is moved. */
+    auto operator=(small_ring_vector&& other) -> small_ring_vector& {
+        if (this == &other) {
+            return *this;
+        }
+
+        destroy();
+        if constexpr (allc_tr::propagate_on_container_move_assignment::value) {
+            alloc_ = std::move(other.alloc_);
+            take(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                take(other);
+            } else {
+                construct_from(std::move(other));
+                other.clear();
+            }
+        }
+
+        return *this;
+    }
+
+    /** Swaps contents with other. Allocators are swapped only if propagate_on_container_swap is set, otherwise
+     *  they must compare equal. Inline elements are moved, heap arrays are exchanged. */
+    auto swap(small_ring_vector& other) -> void {
+        if constexpr (allc_tr::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
+        auto held = small_ring_vector(alloc_);
+        held.take(*this);
+        take(other);
+        other.take(held);
+    }
+
+    /** Returns a copy of the allocator */
+    auto get_allocator() const -> allocator_type { return alloc_; }
+
+
+    /* ========================================================== */
+    /* ====================  ELEMENT ACCESS  ==================== */
+
+    /** Returns reference to an element at the given position */
+    auto at(ui32 pos)       -> reference       { return array_[(pos + begin_) & idx_mask_]; }
+    /** Returns const reference to an element at the given position */
+    auto at(ui32 pos) const -> const_reference { return array_[(pos + begin_) & idx_mask_]; }
+
+    /** Returns reference to an element at the given position */
+    auto operator[](ui32 pos)       -> reference       { return array_[(pos + begin_) & idx_mask_]; }
+    /** Returns const reference to an element at the given position */
+    auto operator[](ui32 pos) const -> const_reference { return array_[(pos + begin_) & idx_mask_]; }
+
+    /** Returns reference to first element in vector */
+    auto front()       -> reference       { return array_[begin_]; }
+    /** Returns const reference to first element in vector */
+    auto front() const -> const_reference { return array_[begin_]; }
+
+    /** Returns reference to last element in vector */
+    auto back()       -> reference       { return array_[(begin_ + size_ - 1) & idx_mask_]; }
+    /** Returns const reference to last element in vector */
+    auto back() const -> const_reference { return array_[(begin_ + size_ - 1) & idx_mask_]; }
+
+
+    /* ========================================================== */
+    /* =======================  ITERATORS  ====================== */
+
+    using iterator       = index_iterator<small_ring_vector, T>;
+    using const_iterator = index_iterator<small_ring_vector, T const>;
+
+    /** Returns random access iterator on this vector starting at front */
+    auto begin() -> iterator { return {*this, 0}; }
+    /** Returns end position of random access iterator */
+    auto end()   -> iterator { return {*this, size_}; }
+
+    /** Returns const random access iterator on this vector starting at front */
+    auto begin() const -> const_iterator { return {*this, 0}; }
+    /** Returns end position of const random access iterator */
+    auto end()   const -> const_iterator { return {*this, size_}; }
+
+    /** Returns const random access iterator on this vector starting at front */
+    auto cbegin() const -> const_iterator { return {*this, 0}; }
+    /** Returns end position of const random access iterator */
+    auto cend()   const -> const_iterator { return {*this, size_}; }
+
+
+    /* ========================================================== */
+    /* ========================  CAPACITY  ====================== */
+
+    /** Returns true if size of vector is 0 */
+    auto empty()    const -> bool { return size_ == 0; }
+
+    /** Returns number of elements being used in array */
+    auto size()     const -> ui32 { return size_; }
+
+    /** Returns number of reserved array elements */
+    auto capacity() const -> ui32 { return capacity_; }
+
+    /** Returns true if elements have spilled from inline storage to the heap */
+    auto spilled()  const -> bool { return !is_inline(); }
+
+    /** Grows capacity to at least new_capacity, rounded up to a power of 2. Never shrinks. */
+    auto reserve(ui32 new_capacity) -> void {
+        if (new_capacity > capacity_) {
+            resize(std::bit_ceil(new_capacity));
+        }
+    }
+
+
+    /* ========================================================== */
+    /* ========================  MODIFIERS  ===================== */
+
+    /** Remove all elements from the vector. Keeps the current storage. */
+    auto clear() -> void {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (ui32 idx=0; idx < size_; idx++) {
+                allc_tr::destroy(alloc_, &(*this)[idx]);
+            }
+        }
+        begin_ = 0;
+        size_  = 0;
+    }
+
+    /** Place one element at the end of the vector. Spills to the heap once inline capacity is exceeded. */
+    auto push_back(T value) -> void {
+        emplace_back(std::move(value));
+    }
+
+    template<typename... Args>
+    auto emplace_back(Args&&... args) -> void {
+        if (size_ >= capacity_) {
+            resize(capacity_ * 2);
+        }
+        allc_tr::construct(alloc_, array_ + ((begin_ + size_) & idx_mask_), std::forward<Args>(args)...);
+        size_++;
+    }
+
+    /** Place one element at the beginning of the vector. Spills to the heap once inline capacity is exceeded. */
+    auto push_front(T value) -> void {
+        emplace_front(std::move(value));
+    }
+
+    template<typename... Args>
+    auto emplace_front(Args&&... args) -> void {
+        if (size_ >= capacity_) {
+            resize(capacity_ * 2);
+        }
+        begin_ = (begin_ - 1) & idx_mask_;
+        allc_tr::construct(alloc_, array_ + begin_, std::forward<Args>(args)...);
+        size_++;
+    }
+
+    /** Remove one element from the end of the vector */
+    auto pop_back() -> void {
+        size_--;
+        allc_tr::destroy(alloc_, array_ + ((begin_ + size_) & idx_mask_));
+    }
+
+    /** Remove one element from the end of the vector and return the element */
+    auto pop_back_get() -> T {
+        T temp = std::move(back());
+        pop_back();
+        return temp;
+    }
+
+    /** Remove one element from the beginning of the vector */
+    auto pop_front() -> void {
+        allc_tr::destroy(alloc_, array_ + begin_);
+        begin_ = (begin_ + 1) & idx_mask_;
+        size_--;
+    }
+
+    /** Remove one element from the beginning of the vector and return the element */
+    auto pop_front_get() -> T {
+        T temp = std::move(front());
+        pop_front();
+        return temp;
+    }
+};
+
+namespace pmr {
+
+/** small_ring_vector which allocates from a std::pmr::memory_resource once it spills */
+template<typename T, std::size_t N>
+using small_ring_vector = dsc::small_ring_vector<T, N, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace dsc
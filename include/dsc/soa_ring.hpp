@@ -0,0 +1,499 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "dsc/segmented.hpp"
+
+namespace dsc {
+
+/** Structure of arrays ring buffer. Each field Ts of a record is stored in its own power of 2 array, and all columns
+ *  share one begin_/end_/idx_mask_, so record i is at the same slot in every column. Loops which only touch one or
+ *  two fields then stream through just those columns instead of dragging whole records through the cache.
+ *
+ *  Records are pushed and popped as tuples. column<I>() returns field I as a segment_pair of up to two contiguous
+ *  spans, which can be scanned with plain vectorizable loops or passed to the segmented algorithms.
+ *
+ *  Allocator is rebound to each column's field type. It comes first because Ts is a pack, and soa_ring<Ts...> names
+ *  the ring with std::allocator. */
+template<typename Allocator, typename... Ts>
+class basic_soa_ring {
+    static_assert(sizeof...(Ts) > 0, "soa_ring requires at least one column");
+
+    using ui32    = std::size_t;
+    using columns = std::index_sequence_for<Ts...>;
+    using allc_tr = std::allocator_traits<Allocator>;
+
+    template<std::size_t I>
+    using column_t = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    template<std::size_t I>
+    using column_alloc_t = typename allc_tr::template rebind_alloc<column_t<I>>;
+
+    template<std::size_t I>
+    using column_tr = std::allocator_traits<column_alloc_t<I>>;
+
+    Allocator           alloc_;
+    std::tuple<Ts*...>  arrays_;
+    ui32                begin_,
+                        end_,
+                        size_,
+                        capacity_,
+                        idx_mask_;
+
+    /** Calls f with std::integral_constant<std::size_t, I> for each column I in order */
+    template<typename F>
+    static auto for_each_column(F&& f) -> void {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (f(std::integral_constant<std::size_t, I>{}), ...);
+        }(columns{});
+    }
+
+    /** Returns the allocator for column I */
+    template<std::size_t I>
+    auto column_alloc() const -> column_alloc_t<I> { return column_alloc_t<I>(alloc_); }
+
+    /** Constructs the records of column I in order into dst, starting at slot 0. Elements are moved unless their move
+     *  may throw and they can be copied, so a throw leaves this ring intact. On a throw the elements already built in
+     *  dst are destroyed. */
+    template<std::size_t I>
+    auto relocate_column(column_t<I>* dst) -> void {
+        using T = column_t<I>;
+        T* src  = std::get<I>(arrays_);
+
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            // src is still null on the first resize, when there is nothing to copy
+            if (size_ != 0) {
+                auto first = std::min(size_, capacity_ - begin_);
+                std::memcpy(dst, src + begin_, first * sizeof(T));
+                std::memcpy(dst + first, src, (size_ - first) * sizeof(T));
+            }
+        } else {
+            auto alloc = column_alloc<I>();
+            ui32 idx   = 0;
+            try {
+                for (; idx < size_; idx++) {
+                    column_tr<I>::construct(alloc, dst + idx, std::move_if_noexcept(src[(begin_ + idx) & idx_mask_]));
+                }
+            } catch (...) {
+                for (ui32 built=0; built < idx; built++) {
+                    column_tr<I>::destroy(alloc, dst + built);
+                }
+                throw;
+            }
+        }
+    }
+
+    /** Moves every column into new arrays of new_capacity, with the records in order starting at slot 0. Every new
+     *  array is allocated and filled before any column is replaced, so if an allocation or a copy throws the ring is
+     *  left unchanged. */
+    auto resize(ui32 new_capacity) -> void {
+        auto fresh     = std::tuple<Ts*...>{};
+        auto allocated = std::size_t{0};
+        auto filled    = std::size_t{0};
+        try {
+            for_each_column([&](auto col) {
+                constexpr auto I   = decltype(col)::value;
+                auto           alloc = column_alloc<I>();
+                std::get<I>(fresh) = column_tr<I>::allocate(alloc, new_capacity);
+                allocated++;
+            });
+            for_each_column([&](auto col) {
+                constexpr auto I = decltype(col)::value;
+                relocate_column<I>(std::get<I>(fresh));
+                filled++;
+            });
+        } catch (...) {
+            for_each_column([&](auto col) {
+                constexpr auto I     = decltype(col)::value;
+                auto           alloc = column_alloc<I>();
+                if (I < filled) {
+                    for (ui32 idx=0; idx < size_; idx++) {
+                        column_tr<I>::destroy(alloc, std::get<I>(fresh) + idx);
+                    }
+                }
+                if (I < allocated) {
+                    column_tr<I>::deallocate(alloc, std::get<I>(fresh), new_capacity);
+                }
+            });
+            throw;
+        }
+
+        auto count = size_;
+        destroy();
+        arrays_   = fresh;
+        begin_    = 0;
+        end_      = count & (new_capacity - 1);
+        size_     = count;
+        capacity_ = new_capacity;
+        idx_mask_ = new_capacity - 1;
+    }
+
+    /** Destroys all records and releases every column, leaving the ring with no storage */
+    auto destroy() -> void {
+        clear();
+        for_each_column([&](auto col) {
+            constexpr auto I     = decltype(col)::value;
+            auto           alloc = column_alloc<I>();
+            if (auto* array = std::exchange(std::get<I>(arrays_), nullptr); array != nullptr) {
+                column_tr<I>::deallocate(alloc, array, capacity_);
+            }
+        });
+        capacity_ = 0;
+        idx_mask_ = 0;
+    }
+
+    /** Takes every column of other, leaving it empty with no storage. This ring must already be destroyed. */
+    auto steal(basic_soa_ring& other) -> void {
+        arrays_   = std::exchange(other.arrays_, {});
+        begin_    = std::exchange(other.begin_, 0);
+        end_      = std::exchange(other.end_, 0);
+        size_     = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, 0);
+        idx_mask_ = std::exchange(other.idx_mask_, 0);
+    }
+
+    /** Reserves other's capacity through this ring's allocator and copies each record of other, or moves them if
+     *  other is an rvalue. This ring must already be destroyed. */
+    template<typename Other>
+    auto construct_from(Other&& other) -> void {
+        reserve(other.capacity_);
+        for (ui32 idx=0; idx < other.size_; idx++) {
+            if constexpr (std::is_rvalue_reference_v<Other&&>) {
+                std::apply([&](auto&... fields) { emplace_back(std::move(fields)...); }, other[idx]);
+            } else {
+                std::apply([&](auto const&... fields) { emplace_back(fields...); }, other[idx]);
+            }
+        }
+    }
+
+    /** Constructs one field of the record at slot from value */
+    template<std::size_t I, typename Arg>
+    auto construct_field(ui32 slot, Arg&& value) -> void {
+        auto alloc = column_alloc<I>();
+        column_tr<I>::construct(alloc, std::get<I>(arrays_) + slot, std::forward<Arg>(value));
+    }
+
+    /** Destroys every field of the record at slot */
+    auto destroy_at(ui32 slot) -> void {
+        for_each_column([&](auto col) {
+            constexpr auto I     = decltype(col)::value;
+            auto           alloc = column_alloc<I>();
+            column_tr<I>::destroy(alloc, std::get<I>(arrays_) + slot);
+        });
+    }
+
+    /** Moves the record at slot out into a tuple and destroys it */
+    auto take_at(ui32 slot) -> std::tuple<Ts...> {
+        auto record = [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::tuple<Ts...>{std::move(std::get<I>(arrays_)[slot])...};
+        }(columns{});
+        destroy_at(slot);
+        return record;
+    }
+
+    /** Constructs the record at slot with one argument per column */
+    template<typename... Args>
+    auto construct_record(ui32 slot, Args&&... args) -> void {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (construct_field<I>(slot, std::forward<Args>(args)), ...);
+        }(columns{});
+    }
+
+    /** Returns a segment_pair over slots of one column, splitting where the records wrap */
+    template<typename T>
+    auto segments(T* array) const -> segment_pair<T> {
+        if (begin_ + size_ <= capacity_) {
+            return {{array + begin_, size_}, {}};
+        }
+        return {{array + begin_, capacity_ - begin_}, {array, end_}};
+    }
+
+ public:
+    using value_type      = std::tuple<Ts...>;
+    using allocator_type  = Allocator;
+    using reference       = std::tuple<Ts&...>;
+    using const_reference = std::tuple<Ts const&...>;
+    using size_type       = ui32;
+
+    /** Allocates an empty ring with 4 spaces reserved in each column */
+    basic_soa_ring(): basic_soa_ring(4) {}
+
+    /** Allocates an empty ring with 4 spaces reserved in each column, allocating all of its memory through alloc */
+    explicit basic_soa_ring(Allocator const& alloc): basic_soa_ring(4, alloc) {}
+
+    /** Allocates an empty ring with reserve_space reserved in each column, rounded up to a power of 2 */
+    explicit basic_soa_ring(ui32 reserve_space, Allocator const& alloc = Allocator()): alloc_(alloc),
+                                                                                      arrays_(),
+                                                                                      begin_(0),
+                                                                                      end_(0),
+                                                                                      size_(0),
+                                                                                      capacity_(0),
+                                                                                      idx_mask_(0) {
+        resize(std::bit_ceil(std::max<ui32>(reserve_space, 4)));
+    }
+
+    /** Copy constructor which copies each record field by field. The allocator is chosen by
+     *  select_on_container_copy_construction. */
+    basic_soa_ring(basic_soa_ring const& other):
+        basic_soa_ring(other, allc_tr::select_on_container_copy_construction(other.alloc_)) {}
+
+    /** Copy constructor which allocates through alloc */
+    basic_soa_ring(basic_soa_ring const& other, Allocator const& alloc): basic_soa_ring(other.capacity_, alloc) {
+        construct_from(other);
+    }
+
+    /** Move constructor which steals every column and the allocator of other, leaving it empty with no storage */
+    basic_soa_ring(basic_soa_ring&& other) noexcept: alloc_(std::move(other.alloc_)) {
+        steal(other);
+    }
+
+    /** Move constructor which allocates through alloc. Takes other's columns if alloc compares equal to other's
+     *  allocator, otherwise moves each record into new columns. */
+    basic_soa_ring(basic_soa_ring&& other, Allocator const& alloc): alloc_(alloc), arrays_(), begin_(0), end_(0),
+                                                                    size_(0), capacity_(0), idx_mask_(0) {
+        if (alloc_ == other.alloc_) {
+            steal(other);
+        } else {
+            construct_from(std::move(other));
+        }
+    }
+
+    ~basic_soa_ring() {
+        destroy();
+    }
+
+    /** Replaces the contents with a copy of other. The allocator is replaced by other's only if
+     *  propagate_on_container_copy_assignment is set. */
+    auto operator=(basic_soa_ring const& other) -> basic_soa_ring& {
+        if (this == &other) {
+            return *this;
+        }
+
+        destroy();
+        if constexpr (allc_tr::propagate_on_container_copy_assignment::value) {
+            alloc_ = other.alloc_;
+        }
+        construct_from(other);
+
+        return *this;
+    }
+
+    /** Replaces the contents with those of other, leaving other empty. other's columns are taken over when the
+     *  allocator propagates on move assignment or the allocators compare equal, otherwise each record is moved into
+     *  new columns from this ring's allocator. */
+    auto operator=(basic_soa_ring&& other) -> basic_soa_ring& {
+        if (this == &other) {
+            return *this;
+        }
+
+        destroy();
+        if constexpr (allc_tr::propagate_on_container_move_assignment::value) {
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                steal(other);
+            } else {
+                construct_from(std::move(other));
+                other.clear();
+            }
+        }
+
+        return *this;
+    }
+
+    /** Swaps contents with other. Allocators are swapped only if propagate_on_container_swap is set, otherwise
+     *  they must compare equal. */
+    auto swap(basic_soa_ring& other) -> void {
+        if constexpr (allc_tr::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
+        std::swap(arrays_,   other.arrays_);
+        std::swap(begin_,    other.begin_);
+        std::swap(end_,      other.end_);
+        std::swap(size_,     other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(idx_mask_, other.idx_mask_);
+    }
+
+    /** Returns a copy of the allocator */
+    auto get_allocator() const -> allocator_type { return alloc_; }
+
+
+    /* ========================================================== */
+    /* ====================  ELEMENT ACCESS  ==================== */
+
+    /** Returns a tuple of references to every field of the record at the given position */
+    auto operator[](ui32 pos) -> reference {
+        auto slot = (pos + begin_) & idx_mask_;
+        return std::apply([slot](auto*... arrays) { return reference{arrays[slot]...}; }, arrays_);
+    }
+    /** Returns a tuple of const references to every field of the record at the given position */
+    auto operator[](ui32 pos) const -> const_reference {
+        auto slot = (pos + begin_) & idx_mask_;
+        return std::apply([slot](auto*... arrays) { return const_reference{arrays[slot]...}; }, arrays_);
+    }
+
+    /** Returns reference to field I of the record at the given position */
+    template<std::size_t I>
+    auto get(ui32 pos)       -> column_t<I>&       { return std::get<I>(arrays_)[(pos + begin_) & idx_mask_]; }
+    /** Returns const reference to field I of the record at the given position */
+    template<std::size_t I>
+    auto get(ui32 pos) const -> column_t<I> const& { return std::get<I>(arrays_)[(pos + begin_) & idx_mask_]; }
+
+    /** Returns tuple of references to the first record */
+    auto front()       -> reference       { return (*this)[0]; }
+    /** Returns tuple of const references to the first record */
+    auto front() const -> const_reference { return (*this)[0]; }
+
+    /** Returns tuple of references to the last record */
+    auto back()       -> reference       { return (*this)[size_ - 1]; }
+    /** Returns tuple of const references to the last record */
+    auto back() const -> const_reference { return (*this)[size_ - 1]; }
+
+
+    /* ========================================================== */
+    /* ========================  COLUMNS  ======================= */
+
+    /** Returns field I of every record in order as up to two contiguous spans. The second span is empty when the
+     *  records do not wrap. Invalidated by any operation which grows the ring. */
+    template<std::size_t I>
+    auto column() -> segment_pair<column_t<I>> { return segments(std::get<I>(arrays_)); }
+
+    /** Returns field I of every record in order as up to two contiguous const spans. The second span is empty when
+     *  the records do not wrap. Invalidated by any operation which grows the ring. */
+    template<std::size_t I>
+    auto column() const -> segment_pair<column_t<I> const> {
+        return segments(static_cast<column_t<I> const*>(std::get<I>(arrays_)));
+    }
+
+
+    /* ========================================================== */
+    /* ========================  CAPACITY  ====================== */
+
+    /** Returns true if there are no records */
+    auto empty()    const -> bool { return size_ == 0; }
+
+    /** Returns number of records */
+    auto size()     const -> ui32 { return size_; }
+
+    /** Returns number of records each column has space for */
+    auto capacity() const -> ui32 { return capacity_; }
+
+    /** Returns the number of columns */
+    static constexpr auto columns_count() -> ui32 { return sizeof...(Ts); }
+
+    /** Grows every column to at least new_capacity, rounded up to a power of 2. Never shrinks. */
+    auto reserve(ui32 new_capacity) -> void {
+        if (new_capacity > capacity_) {
+            resize(std::bit_ceil(new_capacity));
+        }
+    }
+
+
+    /* ========================================================== */
+    /* ========================  MODIFIERS  ===================== */
+
+    /** Remove all records */
+    auto clear() -> void {
+        if constexpr (!(std::is_trivially_destructible_v<Ts> && ...)) {
+            for (ui32 idx=0; idx < size_; idx++) {
+                destroy_at((begin_ + idx) & idx_mask_);
+            }
+        }
+        begin_ = 0;
+        end_   = 0;
+        size_  = 0;
+    }
+
+    /** Place one record at the end, splitting its fields across the columns. May grow every column. */
+    auto push_back(value_type record) -> void {
+        std::apply([&](auto&... fields) { emplace_back(std::move(fields)...); }, record);
+    }
+
+    /** Constructs one record at the end from one argument per column. May grow every column. */
+    template<typename... Args>
+    requires (sizeof...(Args) == sizeof...(Ts))
+    auto emplace_back(Args&&... args) -> void {
+        if (size_ >= capacity_) {
+            resize(std::max<ui32>(capacity_ * 2, 4));
+        }
+
+        construct_record(end_, std::forward<Args>(args)...);
+        end_ = (end_ + 1) & idx_mask_;
+        size_++;
+    }
+
+    /** Place one record at the beginning, splitting its fields across the columns. May grow every column. */
+    auto push_front(value_type record) -> void {
+        std::apply([&](auto&... fields) { emplace_front(std::move(fields)...); }, record);
+    }
+
+    /** Constructs one record at the beginning from one argument per column. May grow every column. */
+    template<typename... Args>
+    requires (sizeof...(Args) == sizeof...(Ts))
+    auto emplace_front(Args&&... args) -> void {
+        if (size_ >= capacity_) {
+            resize(std::max<ui32>(capacity_ * 2, 4));
+        }
+
+        auto slot = (begin_ - 1) & idx_mask_;
+        construct_record(slot, std::forward<Args>(args)...);
+        begin_ = slot;
+        size_++;
+    }
+
+    /** Remove one record from the end */
+    auto pop_back() -> void {
+        end_ = (end_ - 1) & idx_mask_;
+        size_--;
+        destroy_at(end_);
+    }
+
+    /** Remove one record from the end and return it as a tuple */
+    auto pop_back_get() -> value_type {
+        end_ = (end_ - 1) & idx_mask_;
+        size_--;
+        return take_at(end_);
+    }
+
+    /** Remove one record from the beginning */
+    auto pop_front() -> void {
+        destroy_at(begin_);
+        begin_ = (begin_ + 1) & idx_mask_;
+        size_--;
+    }
+
+    /** Remove one record from the beginning and return it as a tuple */
+    auto pop_front_get() -> value_type {
+        auto record = take_at(begin_);
+        begin_ = (begin_ + 1) & idx_mask_;
+        size_--;
+        return record;
+    }
+};
+
+/** Structure of arrays ring buffer allocating through std::allocator. See basic_soa_ring. */
+template<typename... Ts>
+using soa_ring = basic_soa_ring<std::allocator<std::byte>, Ts...>;
+
+namespace pmr {
+
+/** soa_ring which allocates every column from a std::pmr::memory_resource */
+template<typename... Ts>
+using soa_ring = dsc::basic_soa_ring<std::pmr::polymorphic_allocator<std::byte>, Ts...>;
+
+}  // namespace pmr
+
+}  // namespace dsc
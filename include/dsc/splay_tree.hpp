@@ -3,12 +3,13 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <utility>
 #include <type_traits>
 #include <vector>
 
 #include "splay_tree_node.hpp"
-#include "ring_vector.hpp"
+#include "small_ring_vector.hpp"
 
 using std::size_t;
 
@@ -34,7 +35,8 @@ class splay_tree {
                 "splay_type must either be fullsplay or semisplay");
 
  private:
-    using stnode = splay_tree_node<T>;
+    using stnode  = splay_tree_node<T>;
+    using allc_tr = std::allocator_traits<Allocator>;
 
     ////////////////////////////////////////////////////////////////
     // ------------------------- FIELDS ------------------------- //
@@ -302,26 +304,62 @@ class splay_tree {
         make_tree_from_vec(node->m_right, node, sorted, mid+1, higher);
     }
 
+    /** Destroys every node in post order by following parent pointers, so no extra memory is needed */
     auto destroy() -> void {
-        auto node_queue = ring_vector<stnode*>{m_size/2 + 2};
-        if (!m_root) {
+        stnode* current = m_root;
+        while (current) {
+            if (current->m_left) {
+                current = current->m_left;
+            } else if (current->m_right) {
+                current = current->m_right;
+            } else {
+                stnode* parent = current->m_parent;
+                if (parent) {
+                    (parent->m_left == current ? parent->m_left : parent->m_right) = nullptr;
+                }
+                std::allocator_traits<Allocator>::destroy(m_alloc, current);
+                std::allocator_traits<Allocator>::deallocate(m_alloc, current, 1);
+                current = parent;
+            }
+        }
+        m_root = nullptr;
+        m_size = 0;
+    }
+
+    /** Copies the shape and values of other's tree into this empty tree through this tree's allocator. Walks with an
+     *  explicit stack, since a splay tree can be as deep as it is large. */
+    auto clone_from(splay_tree const& other) -> void {
+        struct pending {
+            stnode const*   src;
+            stnode*         parent;
+            stnode**        link;
+        };
+
+        if (!other.m_root) {
             return;
         }
+        auto stack = small_ring_vector<pending, 16>{};
+        stack.push_back({other.m_root, nullptr, &m_root});
 
-        node_queue.push_back(m_root);
+        while (!stack.empty()) {
+            auto [src, parent, link] = stack.pop_back_get();
+            *link = allc_tr::allocate(m_alloc, 1);
+            allc_tr::construct(m_alloc, *link, src->m_data, parent);
 
-        while (!node_queue.empty()) {
-            stnode *next = node_queue.pop_front_get();
-            if (next->m_left) {
-                node_queue.push_back(next->m_left);
+            if (src->m_right) {
+                stack.push_back({src->m_right, *link, &(*link)->m_right});
             }
-            if (next->m_right) {
-                node_queue.push_back(next->m_right);
+            if (src->m_left) {
+                stack.push_back({src->m_left, *link, &(*link)->m_left});
             }
-
-            std::allocator_traits<Allocator>::destroy(m_alloc, next);
-            std::allocator_traits<Allocator>::deallocate(m_alloc, next, 1);
         }
+        m_size = other.m_size;
+    }
+
+    /** Takes the nodes of other, leaving it empty. Any nodes this tree held must already be destroyed. */
+    auto steal(splay_tree& other) -> void {
+        m_root = std::exchange(other.m_root, nullptr);
+        m_size = std::exchange(other.m_size, 0);
     }
 
  public:
@@ -341,13 +379,42 @@ class splay_tree {
 
     splay_tree(): m_size(0), m_root(nullptr) {}
 
+    /** Constructs an empty tree which allocates its nodes through alloc */
+    explicit splay_tree(Allocator const& alloc): m_size(0), m_root(nullptr), m_alloc(alloc) {}
+
     /**
      * Constructs a balanced tree from a sorted vector.
     */
-    explicit splay_tree(std::vector<T> const& sorted): m_size(sorted.size()), m_root(nullptr), m_alloc() {
+    explicit splay_tree(std::vector<T> const& sorted, Allocator const& alloc = Allocator()): m_size(sorted.size()),
+                                                                                             m_root(nullptr),
+                                                                                             m_alloc(alloc) {
         make_tree_from_vec(m_root, nullptr, sorted, 0, m_size-1);
     }
 
+    /** Copies every node of other. The allocator is chosen by select_on_container_copy_construction. */
+    splay_tree(splay_tree const& other): splay_tree(other, allc_tr::select_on_container_copy_construction(other.m_alloc)) {}
+
+    /** Copies every node of other, allocating through alloc */
+    splay_tree(splay_tree const& other, Allocator const& alloc): m_size(0), m_root(nullptr), m_alloc(alloc) {
+        clone_from(other);
+    }
+
+    /** Takes the nodes and allocator of other, leaving it empty */
+    splay_tree(splay_tree&& other): m_size(0), m_root(nullptr), m_alloc(std::move(other.m_alloc)) {
+        steal(other);
+    }
+
+    /** Takes the nodes of other if alloc compares equal to its allocator, otherwise copies them through alloc. Leaves
+     *  other empty. */
+    splay_tree(splay_tree&& other, Allocator const& alloc): m_size(0), m_root(nullptr), m_alloc(alloc) {
+        if (m_alloc == other.m_alloc) {
+            steal(other);
+        } else {
+            clone_from(other);
+            other.destroy();
+        }
+    }
+
     ~splay_tree() {
         // Most nodes that need to be stored in a breadth first search is half of the total nodes
         destroy();
@@ -387,8 +454,8 @@ class splay_tree {
             return 0;
         }
 
-        auto current_layer  = ring_vector<stnode const*>{};
-        auto next_layer     = ring_vector<stnode const*>{};
+        auto current_layer  = small_ring_vector<stnode const*, 16>{};
+        auto next_layer     = small_ring_vector<stnode const*, 16>{};
         auto height         = 0;
 
         current_layer.push_back(m_root);
@@ -406,7 +473,7 @@ class splay_tree {
                 }
             }
             current_layer = std::move(next_layer);
-            next_layer = ring_vector<stnode const*>{current_layer.size()*2};  // reserve maximum possible spaces
+            next_layer.reserve(current_layer.size()*2);  // reserve maximum possible spaces
         }
         return height;
     }
@@ -516,19 +583,59 @@ class splay_tree {
         return ret;
     }
 
-    template<typename other_splay_type>
-    auto operator=(splay_tree<T, other_splay_type>&& other) -> splay_tree<T, splay_type>& {
+    /** Replaces the tree with a copy of other. The allocator is replaced by other's only if
+     *  propagate_on_container_copy_assignment is set. */
+    auto operator=(splay_tree const& other) -> splay_tree& {
+        if (this == &other) {
+            return *this;
+        }
 
         destroy();
+        if constexpr (allc_tr::propagate_on_container_copy_assignment::value) {
+            m_alloc = other.m_alloc;
+        }
+        clone_from(other);
 
-        m_root       = other.m_root;
-        m_size       = other.m_size;
-        other.m_root = nullptr;
-        other.m_size = 0;
+        return *this;
+    }
+
+    /** Replaces the tree with other's nodes, leaving other empty. The nodes are taken over when the allocator
+     *  propagates on move assignment or the allocators compare equal, otherwise they are copied through this tree's
+     *  allocator. */
+    auto operator=(splay_tree&& other) -> splay_tree& {
+        if (this == &other) {
+            return *this;
+        }
+
+        destroy();
+        if constexpr (allc_tr::propagate_on_container_move_assignment::value) {
+            m_alloc = std::move(other.m_alloc);
+            steal(other);
+        } else {
+            if (m_alloc == other.m_alloc) {
+                steal(other);
+            } else {
+                clone_from(other);
+                other.destroy();
+            }
+        }
 
         return *this;
     }
 
+    /** Swaps nodes with other. Allocators are swapped only if propagate_on_container_swap is set, otherwise they must
+     *  compare equal. */
+    auto swap(splay_tree& other) -> void {
+        if constexpr (allc_tr::propagate_on_container_swap::value) {
+            std::swap(m_alloc, other.m_alloc);
+        }
+        std::swap(m_root, other.m_root);
+        std::swap(m_size, other.m_size);
+    }
+
+    /** Returns a copy of the allocator */
+    auto get_allocator() const -> allocator_type { return m_alloc; }
+
     ////////////////////////////////////////////////////////////////
     // ------------------------ ITERATORS ----------------------- //
     ////////////////////////////////////////////////////////////////
@@ -600,4 +707,16 @@ class splay_tree {
 
 };
 
+namespace pmr {
+
+/** splay_tree which allocates its nodes from a std::pmr::memory_resource */
+template<typename T, typename splay_type=fullsplay>
+using splay_tree = dsc::splay_tree<T, splay_type, std::pmr::polymorphic_allocator<splay_tree_node<T>>>;
+
+/** semisplay_tree which allocates its nodes from a std::pmr::memory_resource */
+template<typename T>
+using semisplay_tree = dsc::splay_tree<T, semisplay, std::pmr::polymorphic_allocator<splay_tree_node<T>>>;
+
+}  // namespace pmr
+
 }  // namespace dsc
@@ -0,0 +1,250 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "dsc/index_iterator.hpp"
+
+namespace dsc {
+
+/** Fixed capacity ring buffer with storage inside the object. N must be a power of 2, so the index mask is a compile
+ *  time constant and element access is a single AND. Nothing is ever allocated, every operation is constexpr, and the
+ *  object holds no pointers, so for a trivially copyable and default constructible T a static_ring is itself
+ *  trivially copyable and can be placed in shared memory.
+ *
+ *  Every slot holds a T at all times. Unused slots hold a default constructed T and popped elements are reset to T{},
+ *  so T must be default constructible. Pushing onto a full ring is undefined; use full() or the try_push functions. */
+template<typename T, std::size_t N>
+class static_ring {
+    static_assert(std::has_single_bit(N), "N must be a power of 2");
+    static_assert(std::is_default_constructible_v<T>, "static_ring requires a default constructible T");
+
+    using ui32 = std::size_t;
+
+    static constexpr ui32 idx_mask_ = N - 1;
+
+    ui32    begin_ = 0;
+    ui32    size_  = 0;
+    T       array_[N] {};
+
+ public:
+    using value_type        = T;
+    using size_type         = ui32;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+    using pointer           = value_type*;
+    using const_pointer     = const value_type*;
+
+    constexpr static_ring() = default;
+
+
+    /* ========================================================== */
+    /* ====================  ELEMENT ACCESS  ==================== */
+
+    /** Returns reference to an element at the given position */
+    constexpr auto at(ui32 pos)       -> reference       { return array_[(pos + begin_) & idx_mask_]; }
+    /** Returns const reference to an element at the given position */
+    constexpr auto at(ui32 pos) const -> const_reference { return array_[(pos + begin_) & idx_mask_]; }
+
+    /** Returns reference to an element at the given position */
+    constexpr auto operator[](ui32 pos)       -> reference       { return array_[(pos + begin_) & idx_mask_]; }
+    /** Returns const reference to an element at the given position */
+    constexpr auto operator[](ui32 pos) const -> const_reference { return array_[(pos + begin_) & idx_mask_]; }
+
+    /** Returns reference to first element */
+    constexpr auto front()       -> reference       { return array_[begin_]; }
+    /** Returns const reference to first element */
+    constexpr auto front() const -> const_reference { return array_[begin_]; }
+
+    /** Returns reference to last element */
+    constexpr auto back()       -> reference       { return array_[(begin_ + size_ - 1) & idx_mask_]; }
+    /** Returns const reference to last element */
+    constexpr auto back() const -> const_reference { return array_[(begin_ + size_ - 1) & idx_mask_]; }
+
+
+    /* ========================================================== */
+    /* =======================  ITERATORS  ====================== */
+
+    using iterator       = index_iterator<static_ring, T>;
+    using const_iterator = index_iterator<static_ring, T const>;
+
+    /** Returns random access iterator starting at front */
+    constexpr auto begin() -> iterator { return {*this, 0}; }
+    /** Returns end position of random access iterator */
+    constexpr auto end()   -> iterator { return {*this, size_}; }
+
+    /** Returns const random access iterator starting at front */
+    constexpr auto begin() const -> const_iterator { return {*this, 0}; }
+    /** Returns end position of const random access iterator */
+    constexpr auto end()   const -> const_iterator { return {*this, size_}; }
+
+    /** Returns const random access iterator starting at front */
+    constexpr auto cbegin() const -> const_iterator { return {*this, 0}; }
+    /** Returns end position of const random access iterator */
+    constexpr auto cend()   const -> const_iterator { return {*this, size_}; }
+
+
+    /* ========================================================== */
+    /* =======================  SEGMENTS  ======================= */
+
+    /** Returns the elements as two contiguous spans in order. The second span is empty when the elements do not wrap. */
+    constexpr auto as_spans() -> std::pair<std::span<T>, std::span<T>> {
+        if (begin_ + size_ <= N) {
+            return {{array_ + begin_, size_}, {}};
+        }
+        return {{array_ + begin_, N - begin_}, {array_, begin_ + size_ - N}};
+    }
+
+    /** Returns the elements as two contiguous const spans in order. The second span is empty when the elements do not
+     *  wrap. */
+    constexpr auto as_spans() const -> std::pair<std::span<T const>, std::span<T const>> {
+        if (begin_ + size_ <= N) {
+            return {{array_ + begin_, size_}, {}};
+        }
+        return {{array_ + begin_, N - begin_}, {array_, begin_ + size_ - N}};
+    }
+
+    /** Calls f on each non-empty contiguous segment in order. If f returns a bool, stops as soon as f returns false.
+     *  Returns false if iteration was stopped early. */
+    template<typename F>
+    constexpr auto for_each_segment(F&& f) -> bool {
+        auto [first, second] = as_spans();
+        return visit_segment(f, first) && visit_segment(f, second);
+    }
+
+    /** Calls f on each non-empty contiguous const segment in order. If f returns a bool, stops as soon as f returns
+     *  false. Returns false if iteration was stopped early. */
+    template<typename F>
+    constexpr auto for_each_segment(F&& f) const -> bool {
+        auto [first, second] = as_spans();
+        return visit_segment(f, first) && visit_segment(f, second);
+    }
+
+ private:
+    template<typename F, typename Span>
+    static constexpr auto visit_segment(F& f, Span segment) -> bool {
+        if (segment.empty()) {
+            return true;
+        }
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, Span>, bool>) {
+            return f(segment);
+        } else {
+            f(segment);
+            return true;
+        }
+    }
+
+ public:
+
+
+    /* ========================================================== */
+    /* ========================  CAPACITY  ====================== */
+
+    /** Returns true if there are no elements */
+    constexpr auto empty() const -> bool { return size_ == 0; }
+
+    /** Returns true if no more elements can be pushed */
+    constexpr auto full()  const -> bool { return size_ == N; }
+
+    /** Returns number of elements */
+    constexpr auto size()  const -> ui32 { return size_; }
+
+    /** Returns the fixed capacity N */
+    static constexpr auto capacity() -> ui32 { return N; }
+
+
+    /* ========================================================== */
+    /* ========================  MODIFIERS  ===================== */
+
+    /** Remove all elements, resetting each to T{} */
+    constexpr auto clear() -> void {
+        while (!empty()) {
+            pop_back();
+        }
+        begin_ = 0;
+    }
+
+    /** Place one element at the end. The ring must not be full. */
+    constexpr auto push_back(T value) -> void {
+        array_[(begin_ + size_) & idx_mask_] = std::move(value);
+        size_++;
+    }
+
+    /** Constructs a T from args and move assigns it over the unused slot at the end, which always holds a T. The ring
+     *  must not be full. */
+    template<typename... Args>
+    constexpr auto emplace_back(Args&&... args) -> void {
+        array_[(begin_ + size_) & idx_mask_] = T(std::forward<Args>(args)...);
+        size_++;
+    }
+
+    /** Place one element at the beginning. The ring must not be full. */
+    constexpr auto push_front(T value) -> void {
+        begin_ = (begin_ - 1) & idx_mask_;
+        array_[begin_] = std::move(value);
+        size_++;
+    }
+
+    /** Constructs a T from args and move assigns it over the unused slot before the beginning, which always holds a
+     *  T. The ring must not be full. */
+    template<typename... Args>
+    constexpr auto emplace_front(Args&&... args) -> void {
+        auto slot = (begin_ - 1) & idx_mask_;
+        array_[slot] = T(std::forward<Args>(args)...);
+        begin_ = slot;
+        size_++;
+    }
+
+    /** Places one element at the end if the ring is not full. Returns false if it was full. */
+    constexpr auto try_push_back(T value) -> bool {
+        if (full()) {
+            return false;
+        }
+        push_back(std::move(value));
+        return true;
+    }
+
+    /** Places one element at the beginning if the ring is not full. Returns false if it was full. */
+    constexpr auto try_push_front(T value) -> bool {
+        if (full()) {
+            return false;
+        }
+        push_front(std::move(value));
+        return true;
+    }
+
+    /** Remove one element from the end */
+    constexpr auto pop_back() -> void {
+        size_--;
+        array_[(begin_ + size_) & idx_mask_] = T{};
+    }
+
+    /** Remove one element from the end and return the element */
+    constexpr auto pop_back_get() -> T {
+        size_--;
+        return std::exchange(array_[(begin_ + size_) & idx_mask_], T{});
+    }
+
+    /** Remove one element from the beginning */
+    constexpr auto pop_front() -> void {
+        array_[begin_] = T{};
+        begin_ = (begin_ + 1) & idx_mask_;
+        size_--;
+    }
+
+    /** Remove one element from the beginning and return the element */
+    constexpr auto pop_front_get() -> T {
+        T temp = std::exchange(array_[begin_], T{});
+        begin_ = (begin_ + 1) & idx_mask_;
+        size_--;
+        return temp;
+    }
+};
+
+}  // namespace dsc
@@ -0,0 +1,225 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dsc/heap.hpp"
+#include "dsc/segmented.hpp"
+
+namespace dsc {
+
+/** Keeps the K greatest elements seen so far, ordered by Compare the way std::less<> orders them, in O(K) memory
+ *  however many elements are pushed.
+ *
+ *  The elements are held in a heap whose top is the worst of them, the threshold a candidate has to beat. Once K
+ *  elements are held a worse candidate costs one comparison and is never moved, and a better one replaces the top
+ *  with a single sift. For arithmetic T, push_range first compares whole blocks against the threshold with a
+ *  reduction the compiler vectorizes, and only looks at the elements of blocks which hold a candidate. */
+template<typename T, std::size_t K, typename Compare = std::less<>, typename Allocator = std::allocator<T>>
+requires (K > 0) && heap_ordering<heap_order<Compare>, T>
+class topk_heap {
+ public:
+    using value_type        = T;
+    using allocator_type    = Allocator;
+    using size_type         = std::size_t;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+
+    /** Number of elements kept */
+    static constexpr size_type k = K;
+
+ private:
+    using order_type = heap_order<Compare>;
+
+    /** Elements per block compared against the threshold before any of them is pushed. A kilobyte amortises the
+     *  branch over 128 64 bit keys, while a block holding a candidate is still cheap to scan again. */
+    static constexpr size_type prefilter_block = std::max<size_type>(1024 / sizeof(T), 1);
+
+    heap<T, order_type, Allocator> heap_;
+
+    /** Returns true if value would be kept by a full heap */
+    auto beats_threshold(T const& value) const -> bool { return heap_.order()(heap_.front(), value); }
+
+    /** Pushes len elements from data, skipping each block of prefilter_block elements in which none beats the
+     *  threshold */
+    auto push_block(T const* data, size_type len) -> void {
+        size_type idx = 0;
+        for (; idx < len && !full(); idx++) {
+            heap_.push(data[idx]);
+        }
+        auto const& comp = heap_.order().comp;
+        for (; idx + prefilter_block <= len; idx += prefilter_block) {
+            T    bar = heap_.front();
+            bool any = false;
+            for (size_type j=0; j < prefilter_block; j++) {
+                any |= static_cast<bool>(comp(bar, data[idx+j]));
+            }
+            if (!any) {
+                continue;
+            }
+            for (size_type j=0; j < prefilter_block; j++) {
+                push(data[idx+j]);
+            }
+        }
+        for (; idx < len; idx++) {
+            push(data[idx]);
+        }
+    }
+
+ public:
+    /** Construct an empty top k which allocates through alloc */
+    explicit topk_heap(Allocator const& alloc = Allocator()): topk_heap(Compare{}, alloc) {}
+
+    /** Construct an empty top k ordered by comp, for comparators which carry state */
+    explicit topk_heap(Compare comp, Allocator const& alloc = Allocator()): heap_(order_type{std::move(comp), {}}, K, alloc) {}
+
+    /** Returns a copy of the allocator */
+    auto get_allocator() const -> allocator_type { return heap_.get_allocator(); }
+
+
+    /* ========================================================== */
+    /* ====================  ELEMENT ACCESS  ==================== */
+
+    /** Returns the worst element kept, which a new element has to beat once the heap is full */
+    auto threshold() const -> const_reference { return heap_.front(); }
+
+    /** Returns the elements kept, in no particular order */
+    auto elements() const -> std::span<T const> { return {heap_.data(), heap_.size()}; }
+
+    /** Returns a copy of the elements kept, best first */
+    auto sorted() const -> std::vector<T, Allocator> {
+        auto result = std::vector<T, Allocator>(heap_.data(), heap_.data() + heap_.size(), get_allocator());
+        std::ranges::sort(result, [this](T const& a, T const& b) { return heap_.order()(b, a); });
+        return result;
+    }
+
+
+    /* ========================================================== */
+    /* ========================  CAPACITY  ====================== */
+
+    /** Returns true if there are no elements */
+    auto empty() const -> bool { return heap_.empty(); }
+
+    /** Returns number of elements, which is at most K */
+    auto size() const -> size_type { return heap_.size(); }
+
+    /** Returns true if K elements are held, so a new element has to beat threshold() to be kept */
+    auto full() const -> bool { return heap_.size() == K; }
+
+    /** Returns true if value would be kept by push */
+    auto admits(T const& value) const -> bool { return !full() || beats_threshold(value); }
+
+
+    /* ========================================================== */
+    /* ========================  MODIFIERS  ===================== */
+
+    /** Keeps value if fewer than K elements are held or it beats the threshold, evicting the threshold. Returns
+     *  whether value was kept. */
+    template<typename U = T>
+    requires std::constructible_from<T, U&&>
+    auto push(U&& value) -> bool {
+        if constexpr (!std::same_as<std::remove_cvref_t<U>, T>) {
+            return push(T(std::forward<U>(value)));
+        } else {
+            if (!full()) {
+                heap_.push(std::forward<U>(value));
+                return true;
+            }
+            if (!beats_threshold(value)) {
+                return false;
+            }
+            heap_.replace_top(std::forward<U>(value));
+            return true;
+        }
+    }
+
+    /** Pushes every element of range. Contiguous and segmented ranges of arithmetic T are prefiltered block by
+     *  block against the threshold. */
+    template<std::ranges::input_range R>
+    requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+    auto push_range(R&& range) -> void {
+        constexpr bool prefilter = std::is_arithmetic_v<T> &&
+                                   std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<R>>, T>;
+        if constexpr (prefilter && std::ranges::contiguous_range<R>) {
+            push_block(std::ranges::data(range), std::ranges::size(range));
+        } else if constexpr (prefilter && segmented_range<std::remove_cvref_t<R>>) {
+            range.for_each_segment([this](auto segment) {
+                push_block(segment.data(), segment.size());
+            });
+        } else {
+            for (auto&& value: range) {
+                push(std::forward<decltype(value)>(value));
+            }
+        }
+    }
+
+    /** Keeps the best K of this and other's elements */
+    auto merge(topk_heap const& other) -> void {
+        push_range(other.elements());
+    }
+
+    /** Keeps the best K of this and other's elements, moving from other, which is left empty. The larger array is kept
+     *  rather than refilled when both heaps allocate from the same place. */
+    auto merge(topk_heap&& other) -> void {
+        // Arrays can only trade places when each allocator can free the other's
+        if (other.size() > size() && get_allocator() == other.get_allocator()) {
+            swap(other);
+        }
+        for (auto& value: std::span<T>{other.heap_.data(), other.heap_.size()}) {
+            push(std::move(value));
+        }
+        other.clear();
+    }
+
+    /** Removes every element */
+    auto clear() -> void { heap_.clear(); }
+
+    auto swap(topk_heap& other) noexcept -> void { heap_.swap(other.heap_); }
+};
+
+/** Merges the top k of each element of parts into one, such as the results of one topk_heap per thread. Pairs are
+ *  merged on separate threads in log2(parts.size()) rounds, and parts is left holding moved-from heaps. */
+template<std::ranges::random_access_range R>
+requires std::ranges::sized_range<R>
+auto merge_parallel(R&& parts) -> std::ranges::range_value_t<R> {
+    auto count = std::ranges::size(parts);
+    if (count == 0) {
+        return std::ranges::range_value_t<R>{};
+    }
+
+    auto first = std::ranges::begin(parts);
+    for (std::size_t stride=1; stride < count; stride *= 2) {
+        auto workers = std::vector<std::jthread>{};
+        for (std::size_t idx=0; idx + stride < count; idx += 2*stride) {
+            auto merge_pair = [=] { first[idx].merge(std::move(first[idx + stride])); };
+            if (idx + 3*stride < count) {
+                workers.emplace_back(merge_pair);
+            } else {
+                merge_pair();
+            }
+        }
+    }
+    return std::move(first[0]);
+}
+
+namespace pmr {
+
+/** topk_heap which allocates from a std::pmr::memory_resource */
+template<typename T, std::size_t K, typename Compare = std::less<>>
+using topk_heap = dsc::topk_heap<T, K, Compare, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
+}  // namespace dsc
@@ -0,0 +1,231 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "dsc/ring_vector.hpp"
+
+namespace dsc {
+
+// Windowed aggregate ops with specialized implementations. Any other Op is treated as an associative binary function.
+struct window_min {};
+struct window_max {};
+struct window_moments {};
+
+/** Aggregate over a FIFO window of values, where pushing a new value and evicting the oldest are both amortized O(1).
+ *  If constructed with a window size, push evicts the oldest value automatically once the window is full; otherwise
+ *  values are only evicted by pop().
+ *
+ *  This general version works for any associative Op, such as std::plus<>, std::bit_or<> or a gcd functor, using two
+ *  stack aggregation held in a single ring_vector. The oldest values form the front stack, where each entry stores the
+ *  aggregate of itself and every newer entry in the front stack. Newer values form the back stack, which only needs
+ *  one running aggregate. When the front stack runs out, the back stack is flipped into it by recomputing those
+ *  suffix aggregates once, so every value is combined a constant number of times. */
+template<typename T, typename Op>
+class windowed_aggregate {
+    struct entry {
+        T value;
+        T agg;
+    };
+
+    Op                  op_;
+    ring_vector<entry>  entries_;
+    std::size_t         front_size_;
+    std::size_t         window_;
+    T                   back_agg_;
+
+    /** Turns every entry into part of the front stack by computing suffix aggregates from newest to oldest */
+    auto flip() -> void {
+        auto size = entries_.size();
+        entries_[size-1].agg = entries_[size-1].value;
+        for (std::size_t idx=size-1; idx > 0; idx--) {
+            entries_[idx-1].agg = op_(entries_[idx-1].value, entries_[idx].agg);
+        }
+        front_size_ = size;
+    }
+
+ public:
+    using value_type = T;
+
+    /** Constructs an empty aggregate. A window of 0 never evicts automatically. */
+    explicit windowed_aggregate(std::size_t window = 0, Op op = {}): op_(std::move(op)),
+                                                                     entries_(window),
+                                                                     front_size_(0),
+                                                                     window_(window),
+                                                                     back_agg_() {}
+
+    /** Adds a value as the newest in the window, first evicting the oldest if the window is full */
+    auto push(T value) -> void {
+        if (window_ != 0 && entries_.size() == window_) {
+            pop();
+        }
+
+        if (entries_.size() == front_size_) {
+            back_agg_ = value;
+        } else {
+            back_agg_ = op_(back_agg_, value);
+        }
+        entries_.push_back({value, value});
+    }
+
+    /** Evicts the oldest value in the window */
+    auto pop() -> void {
+        if (front_size_ == 0) {
+            flip();
+        }
+        entries_.pop_front();
+        front_size_--;
+    }
+
+    /** Returns the aggregate of every value in the window, oldest to newest. The window must not be empty. */
+    auto value() const -> T {
+        if (front_size_ == 0) {
+            return back_agg_;
+        }
+        if (front_size_ == entries_.size()) {
+            return entries_.front().agg;
+        }
+        return op_(entries_.front().agg, back_agg_);
+    }
+
+    /** Returns the number of values in the window */
+    auto size()   const -> std::size_t { return entries_.size(); }
+    /** Returns true if there are no values in the window */
+    auto empty()  const -> bool        { return entries_.empty(); }
+    /** Returns the window size, or 0 if values are only evicted by pop() */
+    auto window() const -> std::size_t { return window_; }
+};
+
+
+/** Windowed minimum or maximum using a monotonic deque. Only values which could still become the extremum are kept,
+ *  ordered so the current extremum is always at the front, each tagged with its sequence number so eviction knows
+ *  whether the value leaving the window is the one at the front. */
+template<typename T, typename Compare>
+class windowed_extremum {
+    struct entry {
+        std::uint64_t   seq;
+        T               value;
+    };
+
+    Compare             better_;
+    ring_vector<entry>  candidates_;
+    std::uint64_t       oldest_,
+                        next_;
+    std::size_t         window_;
+
+ public:
+    using value_type = T;
+
+    /** Constructs an empty aggregate. A window of 0 never evicts automatically. */
+    explicit windowed_extremum(std::size_t window = 0): candidates_(), oldest_(0), next_(0), window_(window) {}
+
+    /** Adds a value as the newest in the window, first evicting the oldest if the window is full */
+    auto push(T value) -> void {
+        if (window_ != 0 && size() == window_) {
+            pop();
+        }
+
+        // Anything no better than the new value can never be the extremum again
+        while (!candidates_.empty() && !better_(candidates_.back().value, value)) {
+            candidates_.pop_back();
+        }
+        candidates_.push_back({next_++, std::move(value)});
+    }
+
+    /** Evicts the oldest value in the window */
+    auto pop() -> void {
+        if (candidates_.front().seq == oldest_) {
+            candidates_.pop_front();
+        }
+        oldest_++;
+    }
+
+    /** Returns the extremum of the window. The window must not be empty. */
+    auto value() const -> T const& { return candidates_.front().value; }
+
+    /** Returns the number of values in the window */
+    auto size()   const -> std::size_t { return static_cast<std::size_t>(next_ - oldest_); }
+    /** Returns true if there are no values in the window */
+    auto empty()  const -> bool        { return next_ == oldest_; }
+    /** Returns the window size, or 0 if values are only evicted by pop() */
+    auto window() const -> std::size_t { return window_; }
+};
+
+template<typename T>
+class windowed_aggregate<T, window_min>: public windowed_extremum<T, std::less<>> {
+    using windowed_extremum<T, std::less<>>::windowed_extremum;
+};
+
+template<typename T>
+class windowed_aggregate<T, window_max>: public windowed_extremum<T, std::greater<>> {
+    using windowed_extremum<T, std::greater<>>::windowed_extremum;
+};
+
+
+/** Windowed sum, mean and population variance. The sum is kept exactly in T while mean and variance use Welford's
+ *  update, run in reverse for evictions, which avoids the cancellation of a running sum of squares. */
+template<typename T>
+class windowed_aggregate<T, window_moments> {
+    ring_vector<T>  values_;
+    std::size_t     window_;
+    T               sum_;
+    double          mean_,
+                    m2_;
+
+ public:
+    using value_type = T;
+
+    /** Constructs an empty aggregate. A window of 0 never evicts automatically. */
+    explicit windowed_aggregate(std::size_t window = 0): values_(window), window_(window), sum_(), mean_(0), m2_(0) {}
+
+    /** Adds a value as the newest in the window, first evicting the oldest if the window is full */
+    auto push(T value) -> void {
+        if (window_ != 0 && values_.size() == window_) {
+            pop();
+        }
+
+        auto x     = static_cast<double>(value);
+        auto delta = x - mean_;
+        sum_  += value;
+        values_.push_back(std::move(value));
+        mean_ += delta / static_cast<double>(values_.size());
+        m2_   += delta * (x - mean_);
+    }
+
+    /** Evicts the oldest value in the window */
+    auto pop() -> void {
+        auto value = values_.pop_front_get();
+        sum_ -= value;
+
+        if (values_.empty()) {
+            mean_ = 0;
+            m2_   = 0;
+            return;
+        }
+
+        auto x     = static_cast<double>(value);
+        auto delta = x - mean_;
+        mean_ -= delta / static_cast<double>(values_.size());
+        m2_   -= delta * (x - mean_);
+    }
+
+    /** Returns the sum of the window */
+    auto sum()      const -> T      { return sum_; }
+    /** Returns the mean of the window, or 0 if it is empty */
+    auto mean()     const -> double { return mean_; }
+    /** Returns the population variance of the window, or 0 if it is empty */
+    auto variance() const -> double { return values_.empty() ? 0.0 : m2_ / static_cast<double>(values_.size()); }
+
+    /** Returns the number of values in the window */
+    auto size()   const -> std::size_t { return values_.size(); }
+    /** Returns true if there are no values in the window */
+    auto empty()  const -> bool        { return values_.empty(); }
+    /** Returns the window size, or 0 if values are only evicted by pop() */
+    auto window() const -> std::size_t { return window_; }
+};
+
+}  // namespace dsc
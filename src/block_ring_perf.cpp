@@ -0,0 +1,99 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <cstdint>
+
+#include <dsc/block_ring.hpp>
+#include <dsc/ring_vector.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const NUM_VALUES = 1 << 24;
+auto const NUM_READS  = 1 << 24;
+
+/** Prints the time elapsed since start in seconds */
+auto print_elapsed(char const* label, timer::time_point start) {
+    auto end = timer::now();
+    cout << "   " << label << (std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count()/1000.0) << "\n";
+}
+
+/** Times filling, random reads and FIFO churn on one container type */
+template<typename Container>
+auto run_container() -> void {
+    auto container = Container{};
+    // Volatile sink keeps the optimizer from discarding the loops
+    volatile long long sink = 0;
+
+    {
+        auto start = timer::now();
+        for (auto i=0; i<NUM_VALUES; i++) {
+            container.push_back(i);
+        }
+        print_elapsed("push_back:      ", start);
+    }
+
+    {
+        // Positions come from an inline LCG rather than a precomputed list so the list does not count toward peak RSS
+        auto state = uint64_t{42};
+        auto start = timer::now();
+        auto sum   = 0ll;
+        for (auto i=0; i<NUM_READS; i++) {
+            state = state*6364136223846793005ull + 1442695040888963407ull;
+            sum  += container[(state >> 32) & (NUM_VALUES-1)];
+        }
+        sink = sink + sum;
+        print_elapsed("random reads:   ", start);
+    }
+
+    {
+        auto start = timer::now();
+        for (auto i=0; i<NUM_VALUES; i++) {
+            container.pop_front();
+            container.push_back(i);
+        }
+        print_elapsed("pop/push churn: ", start);
+    }
+
+    {
+        auto start = timer::now();
+        while (!container.empty()) {
+            container.pop_back();
+        }
+        print_elapsed("pop_back:       ", start);
+    }
+}
+
+/** Runs run_container in a child process so that each container reports its own peak resident set size */
+template<typename Container>
+auto run_case(char const* name) -> void {
+    cout << name << ", " << NUM_VALUES << " ints\n";
+    cout.flush();
+
+    auto pid = fork();
+    if (pid == 0) {
+        run_container<Container>();
+        cout.flush();
+        std::_Exit(0);
+    }
+
+    auto status = 0;
+    auto usage  = rusage{};
+    wait4(pid, &status, 0, &usage);
+    cout << "   Peak RSS:       " << (usage.ru_maxrss / 1024) << " MB\n";
+    cout << "\n";
+}
+
+
+auto main() -> int {
+    run_case<dsc::ring_vector<int>>("dsc::ring_vector");
+    run_case<dsc::block_ring<int>>("dsc::block_ring");
+    run_case<std::deque<int>>("std::deque");
+}
@@ -0,0 +1,117 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <deque>
+#include <iterator>
+#include <random>
+#include <string>
+#include <memory_resource>
+#include <utility>
+
+#include "dsc/block_ring.hpp"
+#include "dsc/segmented.hpp"
+
+static_assert(std::random_access_iterator<dsc::block_ring<int>::iterator>);
+
+int main() {
+    std::cout << "Pushing 1..10 with push front/back onto block ring with blocks of 4...\n";
+    auto ring = dsc::block_ring<std::string, std::allocator<std::string>, 4>{};
+    for (int i=1; i<=5; i++) {
+        ring.push_back(std::to_string(i+5));
+        ring.push_front(std::to_string(6-i));
+    }
+
+    std::cout << "Values: ";
+    for (auto& v: ring) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "Size:     " << ring.size() << "\n";
+    std::cout << "Capacity: " << ring.capacity() << "\n\n";
+
+    std::cout << "Holding a reference to element 3 and pushing 1000 elements on both ends...\n";
+    auto& held = ring[2];
+    for (int i=0; i<1000; i++) {
+        ring.push_back("x");
+        ring.push_front("y");
+    }
+    std::cout << "Held reference => Expected: 3, Actual: " << held << "\n\n";
+
+    std::cout << "Using insert() to insert at the beginning, end and middle...\n";
+    auto small = dsc::block_ring<int, std::allocator<int>, 4>{};
+    for (int i=0; i<10; i++) {
+        small.push_back(0);
+    }
+    small.insert(0, 1);
+    small.insert(11, 2);
+    small.insert(6, 3);
+    small.insert(2, 4);
+    std::cout << "Values => Expected: 1 0 4 0 0 0 0 3 0 0 0 0 0 2, Actual: ";
+    for (auto v: small) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "count(small, 0) => Expected: 10, Actual: " << dsc::count(small, 0) << "\n\n";
+
+    std::cout << "Running 100000 random push/pop operations on both ends against std::deque...\n";
+    auto rd      = std::random_device{};
+    auto gen     = std::mt19937{rd()};
+    auto next_op = std::uniform_int_distribution<>(0, 5);
+    auto ints    = dsc::block_ring<int>{};
+    auto check   = std::deque<int>{};
+    auto errors  = 0;
+
+    for (int i=0; i<100000; i++) {
+        auto op = next_op(gen);
+        if (op < 2 || check.empty()) {
+            ints.push_back(i);
+            check.push_back(i);
+        } else if (op < 4) {
+            ints.push_front(i);
+            check.push_front(i);
+        } else if (op == 4) {
+            errors += ints.pop_back_get() != check.back();
+            check.pop_back();
+        } else {
+            errors += ints.pop_front_get() != check.front();
+            check.pop_front();
+        }
+
+        if (!check.empty()) {
+            auto pos = static_cast<size_t>(i) % check.size();
+            errors += ints[pos] != check[pos];
+        }
+    }
+
+    std::cout << "Size:   " << ints.size() << ", Expected: " << check.size() << "\n";
+    std::cout << "Errors => Expected: 0, Actual: " << errors << "\n";
+
+    std::cout << "\nMoving and swapping pmr containers across memory resources...\n";
+    auto arena_a = std::pmr::monotonic_buffer_resource{};
+    auto arena_b = std::pmr::monotonic_buffer_resource{};
+    auto in_a    = dsc::pmr::block_ring<std::string>{&arena_a};
+    for (int i=1; i<=6; i++) {
+        in_a.push_back(std::to_string(i));
+    }
+    auto copy_of_a  = in_a;
+    auto moved_of_a = std::move(in_a);
+    auto in_b       = dsc::pmr::block_ring<std::string>{&arena_b};
+    in_b = std::move(moved_of_a);
+    auto resource_name = [&](auto const& container) {
+        auto* resource = container.get_allocator().resource();
+        return resource == &arena_a ? "a" : resource == &arena_b ? "b" : "default";
+    };
+    std::cout << "Copy resource          => Expected: default, Actual: " << resource_name(copy_of_a) << "\n";
+    std::cout << "Move resource          => Expected: a,       Actual: " << resource_name(moved_of_a) << "\n";
+    std::cout << "Move assigned resource => Expected: b,       Actual: " << resource_name(in_b) << "\n";
+    std::cout << "Moved from size        => Expected: 0,       Actual: " << moved_of_a.size() << "\n";
+    auto other_b = dsc::pmr::block_ring<std::string>{&arena_b};
+    other_b.push_back("x");
+    other_b.swap(in_b);
+    std::cout << "Swapped sizes          => Expected: 1 6,     Actual: " << in_b.size() << " " << other_b.size() << "\n";
+    std::cout << "Values => Expected: 1 2 3 4 5 6, Actual: ";
+    for (auto& v: other_b) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+}
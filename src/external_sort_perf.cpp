@@ -0,0 +1,110 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <dsc/external_sort.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const RECORDS = std::size_t{1} << 25;
+auto const BUDGET  = std::size_t{64} << 20;
+
+/** 64 byte record sorted by key, the size of a cache line */
+struct record {
+    std::uint64_t key;
+    char          payload[56];
+};
+
+struct by_key {
+    auto operator()(record const& a, record const& b) const -> bool { return a.key < b.key; }
+};
+
+/** Writes RECORDS records with keys from a 64 bit linear congruential generator, and returns the sum of the keys */
+auto write_input(std::filesystem::path const& path) -> std::uint64_t {
+    auto out   = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    auto chunk = std::vector<record>(1 << 16);
+    auto state = std::uint64_t{42};
+    auto sum   = std::uint64_t{0};
+    for (std::size_t done=0; done < RECORDS; done += chunk.size()) {
+        for (auto& r: chunk) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            r.key = state;
+            sum  += state;
+        }
+        out.write(reinterpret_cast<char const*>(chunk.data()), static_cast<std::streamsize>(chunk.size() * sizeof(record)));
+    }
+    return sum;
+}
+
+/** Returns true if the records of path are sorted and their keys sum to expected */
+auto verify(std::filesystem::path const& path, std::uint64_t expected) -> bool {
+    auto in     = std::ifstream(path, std::ios::binary);
+    auto chunk  = std::vector<record>(1 << 16);
+    auto sum    = std::uint64_t{0};
+    auto last   = std::uint64_t{0};
+    auto sorted = true;
+    for (std::size_t done=0; done < RECORDS; done += chunk.size()) {
+        in.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(chunk.size() * sizeof(record)));
+        for (auto const& r: chunk) {
+            sorted &= last <= r.key;
+            last    = r.key;
+            sum    += r.key;
+        }
+    }
+    return sorted && sum == expected;
+}
+
+/** Sorts input with options and prints the throughput of each phase */
+auto run(std::filesystem::path const& input, std::filesystem::path const& output,
+         dsc::external_sort_options const& options, std::uint64_t checksum) -> void {
+    auto stats = dsc::external_sort<record>(input, output, options, by_key{});
+    cout << "   Runs: " << stats.runs << ", merges: " << stats.merges << "\n";
+    cout << "   Run phase:   " << stats.run_seconds << " s (" << stats.bytes / 1e6 / stats.run_seconds << " MB/s)\n";
+    cout << "   Merge phase: " << stats.merge_seconds << " s (" << stats.bytes / 1e6 / stats.merge_seconds << " MB/s)\n";
+    cout << "   Elapsed time: " << stats.seconds() << " (" << stats.mb_per_second() << " MB/s sustained)\n";
+    cout << "   Sorted and complete: " << (verify(output, checksum) ? "true" : "false") << "\n";
+}
+
+auto main() -> int {
+    auto dir    = std::filesystem::temp_directory_path();
+    auto input  = dir / "dsc_external_sort_perf_in.bin";
+    auto output = dir / "dsc_external_sort_perf_out.bin";
+
+    cout << "Writing " << RECORDS << " records of " << sizeof(record) << " bytes ("
+         << RECORDS * sizeof(record) / 1e6 << " MB)...\n";
+    auto start    = timer::now();
+    auto checksum = write_input(input);
+    cout << "   Elapsed time: " << std::chrono::duration<double>(timer::now() - start).count() << "\n";
+
+    cout << "Baseline: reading and writing the file once through 1 MiB buffers...\n";
+    {
+        start = timer::now();
+        auto in     = std::ifstream(input, std::ios::binary);
+        auto out    = std::ofstream(output, std::ios::binary | std::ios::trunc);
+        auto buffer = std::vector<char>(1 << 20);
+        while (in.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || in.gcount() > 0) {
+            out.write(buffer.data(), in.gcount());
+        }
+        out.flush();
+        auto seconds = std::chrono::duration<double>(timer::now() - start).count();
+        cout << "   Elapsed time: " << seconds << " (" << RECORDS * sizeof(record) / 1e6 / seconds << " MB/s)\n";
+    }
+
+    auto options = dsc::external_sort_options{};
+    options.memory_budget = BUDGET;
+    cout << "external_sort with a " << (BUDGET >> 20) << " MiB budget and the default 1 MiB merge blocks...\n";
+    run(input, output, options, checksum);
+
+    options.min_block_bytes = std::size_t{256} << 10;
+    cout << "external_sort with a " << (BUDGET >> 20) << " MiB budget and 256 KiB merge blocks, merging every run at once...\n";
+    run(input, output, options, checksum);
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
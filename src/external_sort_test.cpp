@@ -0,0 +1,132 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include "dsc/external_sort.hpp"
+
+struct record {
+    std::uint32_t key;
+    std::uint32_t id;
+    char          payload[8];
+};
+
+struct by_key {
+    auto operator()(record const& a, record const& b) const -> bool { return a.key < b.key; }
+};
+
+/** Writes count records with keys from a 64 bit linear congruential generator, drawn from a small range so keys
+ *  repeat */
+auto write_records(std::filesystem::path const& path, std::size_t count, std::uint64_t seed) -> std::vector<record> {
+    auto records = std::vector<record>(count);
+    for (std::size_t i=0; i < count; i++) {
+        seed       = seed * 6364136223846793005ull + 1442695040888963407ull;
+        records[i] = {static_cast<std::uint32_t>((seed >> 33) % 5000), static_cast<std::uint32_t>(i), "payload"};
+    }
+    auto out = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<char const*>(records.data()), static_cast<std::streamsize>(count * sizeof(record)));
+    return records;
+}
+
+auto read_records(std::filesystem::path const& path) -> std::vector<record> {
+    auto records = std::vector<record>(std::filesystem::file_size(path) / sizeof(record));
+    auto in      = std::ifstream(path, std::ios::binary);
+    in.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(record)));
+    return records;
+}
+
+/** Returns true if sorted is ordered by key and holds the same records as original */
+auto sorted_permutation(std::vector<record> original, std::vector<record> sorted) -> bool {
+    if (!std::ranges::is_sorted(sorted, by_key{})) {
+        return false;
+    }
+    auto by_id = [](record const& a, record const& b) { return a.id < b.id; };
+    std::ranges::sort(original, by_id);
+    std::ranges::sort(sorted, by_id);
+    return std::ranges::equal(original, sorted, [](record const& a, record const& b) {
+        return a.key == b.key && a.id == b.id;
+    });
+}
+
+int main() {
+    auto dir    = std::filesystem::temp_directory_path();
+    auto input  = dir / "dsc_external_sort_in.bin";
+    auto output = dir / "dsc_external_sort_out.bin";
+
+    std::cout << "Sorting 100000 16 byte records with 1 MiB of buffers...\n";
+    auto original = write_records(input, 100'000, 42);
+    auto options  = dsc::external_sort_options{};
+    options.memory_budget   = 1 << 20;
+    options.threads         = 2;
+    options.min_block_bytes = 64 << 10;
+    auto stats    = dsc::external_sort<record>(input, output, options, by_key{});
+    std::cout << "records bytes => Expected: 100000 1600000, Actual: " << stats.records << " " << stats.bytes << "\n";
+    std::cout << "runs          => Expected: 7, Actual: " << stats.runs << "\n";
+    std::cout << "merges        => Expected: 1, Actual: " << stats.merges << "\n";
+    std::cout << "Sorted permutation => Expected: true, Actual: "
+              << (sorted_permutation(original, read_records(output)) ? "true" : "false") << "\n\n";
+
+    std::cout << "Sorting 1000000 records with 256 KiB of buffers, forcing merges of merged runs...\n";
+    original = write_records(input, 1'000'000, 7);
+    options.memory_budget   = 256 << 10;
+    options.threads         = 3;
+    options.min_block_bytes = 16 << 10;
+    stats    = dsc::external_sort<record>(input, output, options, by_key{});
+    std::cout << "runs          => Expected: 245, Actual: " << stats.runs << "\n";
+    std::cout << "More than one merge => Expected: true, Actual: " << (stats.merges > 1 ? "true" : "false") << "\n";
+    std::cout << "Sorted permutation => Expected: true, Actual: "
+              << (sorted_permutation(original, read_records(output)) ? "true" : "false") << "\n\n";
+
+    std::cout << "Sorting plain integers in descending order...\n";
+    {
+        auto values = std::vector<std::uint64_t>{5, 3, 9, 1, 7, 2, 8};
+        auto out    = std::ofstream(input, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<char const*>(values.data()), static_cast<std::streamsize>(values.size() * 8));
+    }
+    options.memory_budget = 64;
+    dsc::external_sort<std::uint64_t>(input, output, options, std::greater<>{});
+    {
+        auto values = std::vector<std::uint64_t>(7);
+        auto in     = std::ifstream(output, std::ios::binary);
+        in.read(reinterpret_cast<char*>(values.data()), 7 * 8);
+        std::cout << "Sorted => Expected: 9 8 7 5 3 2 1, Actual: ";
+        for (auto v: values) {
+            std::cout << v << " ";
+        }
+        std::cout << "\n\n";
+    }
+
+    std::cout << "Edge cases...\n";
+    std::ofstream(input, std::ios::binary | std::ios::trunc).close();
+    stats = dsc::external_sort<record>(input, output, options, by_key{});
+    std::cout << "Empty input gives empty output => Expected: 0 0, Actual: " << stats.records << " "
+              << std::filesystem::file_size(output) << "\n";
+
+    std::ofstream(input, std::ios::binary | std::ios::trunc) << "seventeen bytes!!";
+    try {
+        dsc::external_sort<record>(input, output, options, by_key{});
+        std::cout << "Partial record => Expected: runtime_error, Actual: no error\n";
+    } catch (std::system_error const&) {
+        std::cout << "Partial record => Expected: runtime_error, Actual: system_error\n";
+    } catch (std::runtime_error const&) {
+        std::cout << "Partial record => Expected: runtime_error, Actual: runtime_error\n";
+    }
+
+    try {
+        dsc::external_sort<record>(dir / "dsc_external_sort_missing.bin", output, options, by_key{});
+        std::cout << "Missing input  => Expected: system_error, Actual: no error\n";
+    } catch (std::system_error const&) {
+        std::cout << "Missing input  => Expected: system_error, Actual: system_error\n";
+    }
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+    return 0;
+}
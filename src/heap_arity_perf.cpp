@@ -0,0 +1,71 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <dsc/heap.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const MAX_POPS = 1 << 22;
+
+/** Returns the next value of a 64 bit linear congruential generator */
+auto lcg(std::uint64_t& state) -> std::uint64_t {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return state >> 16;
+}
+
+/** Times pushing count random values onto an Arity-ary min heap, then popping up to MAX_POPS of them */
+template<typename T, std::size_t Arity>
+auto time_arity(std::size_t count) -> void {
+    auto heap  = dsc::heap<T, dsc::min_heap, std::allocator<T>, Arity>{};
+    auto state = std::uint64_t{42};
+
+    auto start = timer::now();
+    for (std::size_t i=0; i<count; i++) {
+        heap.push(static_cast<T>(lcg(state)));
+    }
+    auto push_seconds = std::chrono::duration<double>(timer::now() - start).count();
+
+    auto pops  = std::min<std::size_t>(count, MAX_POPS);
+    auto sum   = T{};
+    start      = timer::now();
+    for (std::size_t i=0; i<pops; i++) {
+        sum += heap.pop();
+    }
+    auto pop_seconds = std::chrono::duration<double>(timer::now() - start).count();
+
+    cout << "   " << Arity << "-ary: " << (count / push_seconds / 1e6) << " M pushes per second, "
+         << (pops / pop_seconds / 1e6) << " M pops per second (checksum " << sum << ")\n";
+}
+
+template<typename T>
+auto time_arities(std::size_t count, char const* type) -> void {
+    cout << "Min heap of " << count << " " << type << "...\n";
+    time_arity<T, 2>(count);
+    time_arity<T, 4>(count);
+    time_arity<T, 8>(count);
+    cout << "\n";
+}
+
+/** Heap sizes are given on the command line, defaulting to 1 thousand, 1 million and 16 million elements */
+auto main(int argc, char *argv[]) -> int {
+    auto sizes = std::vector<std::size_t>{};
+    for (auto i=1; i<argc; i++) {
+        sizes.push_back(static_cast<std::size_t>(std::atoll(argv[i])));
+    }
+    if (sizes.empty()) {
+        sizes = {1'000, 1'000'000, 16'000'000};
+    }
+
+    for (auto count: sizes) {
+        time_arities<std::uint32_t>(count, "uint32_t");
+        time_arities<std::uint64_t>(count, "uint64_t");
+        time_arities<double>(count, "double");
+    }
+}
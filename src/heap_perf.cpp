@@ -0,0 +1,270 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <dsc/heap.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const BIG_HEAP    = 10'000'000;
+auto const SMALL_HEAPS = 100'000;
+auto const ROUNDS      = 1000;
+auto const BULK_LOAD   = 50'000'000;
+auto const TOP_HEAP    = 1'000'000;
+auto const TOP_OPS     = 2'000'000;
+auto const RECORDS     = 1'000'000;
+
+auto allocation_count = 0ll;
+auto move_count       = 0ll;
+
+/** 64 bit key which counts every move construction and move assignment in move_count */
+struct counted_key {
+    std::uint64_t key;
+
+    counted_key(std::uint64_t k): key(k) {}
+    counted_key(counted_key const&) = default;
+    counted_key(counted_key&& other) noexcept: key(other.key) { move_count++; }
+    auto operator=(counted_key const&) -> counted_key& = default;
+    auto operator=(counted_key&& other) noexcept -> counted_key& { key = other.key; move_count++; return *this; }
+    auto operator<=>(counted_key const&) const = default;
+};
+
+/** std::allocator which counts calls to allocate in allocation_count */
+template<typename T>
+struct counting_allocator: std::allocator<T> {
+    using value_type = T;
+
+    counting_allocator() = default;
+    template<typename U>
+    counting_allocator(counting_allocator<U> const&) {}
+
+    auto allocate(std::size_t n) -> T* {
+        allocation_count++;
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+using counted_heap = dsc::heap<std::uint64_t, dsc::min_heap, counting_allocator<std::uint64_t>>;
+
+/** Prints the time elapsed since start in microseconds per operation, and the allocations made since before */
+auto print_elapsed(timer::time_point start, long long before, int operations) {
+    auto end = timer::now();
+    auto us  = std::chrono::duration<double, std::micro>(end - start).count();
+    cout << "   Time per operation: " << (us / operations) << " us\n";
+    cout << "   Allocations per operation: " << static_cast<double>(allocation_count - before) / operations << "\n";
+}
+
+/** Returns count random values from a 64 bit linear congruential generator */
+auto random_values(std::size_t count) -> std::vector<std::uint64_t> {
+    auto values = std::vector<std::uint64_t>(count);
+    auto state  = std::uint64_t{42};
+    for (auto& v: values) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        v     = state >> 16;
+    }
+    return values;
+}
+
+/** Times loading values into a min heap with push() and with the range constructor, returning a checksum */
+auto time_bulk_load(std::vector<std::uint64_t> const& values, char const* order) -> std::uint64_t {
+    auto sink = std::uint64_t{0};
+
+    cout << "Loading " << values.size() << " " << order << " values with push()...\n";
+    {
+        auto start = timer::now();
+        auto heap  = dsc::heap<std::uint64_t, dsc::min_heap>{};
+        for (auto v: values) {
+            heap.push(v);
+        }
+        cout << "   Elapsed time: " << std::chrono::duration<double>(timer::now() - start).count() << "\n";
+        sink += heap.front();
+    }
+
+    cout << "Loading " << values.size() << " " << order << " values with the range constructor...\n";
+    {
+        auto start = timer::now();
+        auto heap  = dsc::heap<std::uint64_t, dsc::min_heap>{values};
+        cout << "   Elapsed time: " << std::chrono::duration<double>(timer::now() - start).count() << "\n";
+        sink += heap.front();
+    }
+
+    return sink;
+}
+
+/** Times op on a heap of TOP_HEAP random keys, TOP_OPS times, and prints moves per operation */
+template<typename Op>
+auto time_top_op(char const* name, Op op) -> std::uint64_t {
+    auto values = random_values(TOP_HEAP);
+    auto heap   = dsc::heap<counted_key, dsc::min_heap>{values};
+    auto state  = std::uint64_t{7};
+    auto sum    = std::uint64_t{0};
+
+    cout << name << "...\n";
+    move_count = 0;
+    auto start = timer::now();
+    for (auto i=0; i<TOP_OPS; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        sum  += op(heap, state >> 16);
+    }
+    auto seconds = std::chrono::duration<double>(timer::now() - start).count();
+    cout << "   Operations per second: " << (TOP_OPS / seconds / 1e6) << " M\n";
+    cout << "   Moves per operation: " << static_cast<double>(move_count) / TOP_OPS << "\n";
+    return sum;
+}
+
+/** Record held by pointer, whose priority is read through the pointer */
+struct record {
+    std::uint64_t priority;
+    char          payload[120];
+};
+
+/** Projects a record pointer onto its priority, dereferencing the payload */
+struct record_priority {
+    auto operator()(std::unique_ptr<record> const& r) const -> std::uint64_t { return r->priority; }
+};
+
+/** Pushes RECORDS records, scattered across the heap allocator, onto heap and pops them all */
+template<typename Heap>
+auto time_records(char const* name, Heap heap) -> std::uint64_t {
+    auto records = std::vector<std::unique_ptr<record>>{};
+    auto state   = std::uint64_t{11};
+    for (auto i=0; i<RECORDS; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        records.push_back(std::make_unique<record>(record{state >> 16, {}}));
+    }
+    // Shuffle so neighbouring heap slots point far apart in memory
+    for (auto i=RECORDS-1; i>0; i--) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        std::swap(records[i], records[(state >> 16) % (i + 1)]);
+    }
+
+    cout << name << "...\n";
+    auto sum   = std::uint64_t{0};
+    auto start = timer::now();
+    for (auto& r: records) {
+        heap.push(std::move(r));
+    }
+    while (!heap.empty()) {
+        sum += heap.pop()->priority;
+    }
+    cout << "   Elapsed time: " << std::chrono::duration<double>(timer::now() - start).count() << "\n";
+    return sum;
+}
+
+/** Builds a heap of count descending values, returned by value */
+auto make_heap(std::uint64_t count) -> counted_heap {
+    auto heap = counted_heap{};
+    for (auto i=count; i>0; i--) {
+        heap.push(i);
+    }
+    return heap;
+}
+
+auto main() -> int {
+    auto big  = make_heap(BIG_HEAP);
+    auto sink = std::uint64_t{0};
+
+    cout << "Moving a heap of " << BIG_HEAP << " elements back and forth...\n";
+    {
+        auto other  = counted_heap{};
+        auto before = allocation_count;
+        auto start  = timer::now();
+        for (auto i=0; i<ROUNDS; i++) {
+            other = std::move(big);
+            big   = counted_heap{std::move(other)};
+        }
+        print_elapsed(start, before, ROUNDS * 2);
+        sink += big.front();
+    }
+
+    cout << "Swapping two heaps of " << BIG_HEAP << " elements...\n";
+    {
+        auto other  = make_heap(BIG_HEAP);
+        auto before = allocation_count;
+        auto start  = timer::now();
+        for (auto i=0; i<ROUNDS; i++) {
+            big.swap(other);
+        }
+        print_elapsed(start, before, ROUNDS);
+        sink += other.front();
+    }
+
+    cout << "Copy constructing a heap of " << BIG_HEAP << " elements...\n";
+    {
+        auto before = allocation_count;
+        auto start  = timer::now();
+        for (auto i=0; i<10; i++) {
+            auto const& source = big;
+            auto copy = counted_heap{source};
+            sink += copy.size();
+        }
+        print_elapsed(start, before, 10);
+    }
+
+    cout << "Copy assigning a heap of " << BIG_HEAP << " elements into one of equal capacity...\n";
+    {
+        auto target = make_heap(BIG_HEAP);
+        auto before = allocation_count;
+        auto start  = timer::now();
+        for (auto i=0; i<10; i++) {
+            target = big;
+            sink  += target.size();
+        }
+        print_elapsed(start, before, 10);
+    }
+
+    cout << "Pushing " << SMALL_HEAPS << " heaps of 64 elements by value into a std::vector...\n";
+    {
+        auto heaps  = std::vector<counted_heap>{};
+        auto before = allocation_count;
+        auto start  = timer::now();
+        for (auto i=0; i<SMALL_HEAPS; i++) {
+            heaps.push_back(make_heap(64));
+        }
+        print_elapsed(start, before, SMALL_HEAPS);
+        sink += heaps.back().front();
+    }
+
+    auto values = random_values(BULK_LOAD);
+    sink += time_bulk_load(values, "random");
+
+    // Every push of a descending value into a min heap bubbles all the way to the root
+    std::ranges::sort(values, std::greater<>{});
+    sink += time_bulk_load(values, "descending");
+
+    using key_heap = dsc::heap<counted_key, dsc::min_heap>;
+    sink += time_top_op("pop() then push() on a heap of 1M keys", [](key_heap& heap, std::uint64_t next) {
+        auto top = heap.pop();
+        heap.push(next);
+        return top.key;
+    });
+    sink += time_top_op("pop(out) then push() on a heap of 1M keys", [out = counted_key{0}](key_heap& heap, std::uint64_t next) mutable {
+        heap.pop(out);
+        heap.push(next);
+        return out.key;
+    });
+    sink += time_top_op("replace_top() on a heap of 1M keys", [](key_heap& heap, std::uint64_t next) {
+        auto top = heap.front().key;
+        heap.replace_top(counted_key{next});
+        return top;
+    });
+    sink += time_top_op("push_pop() on a heap of 1M keys", [](key_heap& heap, std::uint64_t next) {
+        return heap.push_pop(counted_key{next}).key;
+    });
+
+    sink += time_records("Pushing and popping 1M records ordered through a pointer projection",
+                         dsc::heap<std::unique_ptr<record>, dsc::heap_order<std::less<>, record_priority>>{});
+    sink += time_records("Pushing and popping 1M records in a cached_key_heap",
+                         dsc::cached_key_heap<std::unique_ptr<record>, record_priority>{});
+
+    cout << "Checksum: " << sink << "\n";
+}
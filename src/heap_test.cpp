@@ -1,10 +1,136 @@
 #include <print>
 #include <format>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <random>
+#include <ranges>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "dsc/heap.hpp"
 
+static auto allocation_count = 0;
+
+/** std::allocator which counts calls to allocate in allocation_count */
+template<typename T>
+struct counting_allocator: std::allocator<T> {
+    using value_type = T;
+
+    counting_allocator() = default;
+    template<typename U>
+    counting_allocator(counting_allocator<U> const&) {}
+
+    auto allocate(std::size_t n) -> T* {
+        allocation_count++;
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+using counted_heap = dsc::heap<std::string, dsc::min_heap, counting_allocator<std::string>>;
+
+/** Builds a heap of the strings "0".."count-1", returned by value */
+auto make_heap(int count) -> counted_heap {
+    auto heap = counted_heap{};
+    for (int i=count-1; i>=0; i--) {
+        heap.push(std::to_string(i));
+    }
+    return heap;
+}
+
+/** Memory resource which throws std::bad_alloc once budget allocations have been made */
+class limited_resource: public std::pmr::memory_resource {
+    auto do_allocate(std::size_t bytes, std::size_t align) -> void* override {
+        if (budget-- <= 0) {
+            throw std::bad_alloc{};
+        }
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    auto do_deallocate(void* p, std::size_t bytes, std::size_t align) -> void override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override { return this == &other; }
+
+ public:
+    int budget = 0;
+};
+
+static auto move_count = 0;
+
+/** Integer wrapper which counts every move construction and move assignment in move_count */
+struct tracked {
+    int value;
+
+    tracked(int v): value(v) {}
+    tracked(tracked const&) = default;
+    tracked(tracked&& other) noexcept: value(other.value) { move_count++; }
+    auto operator=(tracked const&) -> tracked& = default;
+    auto operator=(tracked&& other) noexcept -> tracked& { value = other.value; move_count++; return *this; }
+    auto operator<=>(tracked const&) const = default;
+};
+
+struct task {
+    int         deadline;
+    std::string name;
+
+    auto name_length() const -> std::size_t { return name.size(); }
+};
+
+static auto projections = 0;
+
+/** Projection which counts how often it runs */
+struct counted_deadline {
+    auto operator()(task const& t) const -> int { projections++; return t.deadline; }
+};
+
+/** Pushes shuffled values 0..count-1 and returns true if they pop back out in order */
+template<typename Heap>
+auto pops_in_order(int count, std::mt19937& g) -> bool {
+    auto values = std::vector<int>(count);
+    for (int i=0; i<count; i++) {
+        values[i] = i;
+    }
+    std::shuffle(values.begin(), values.end(), g);
+
+    auto heap = Heap{};
+    for (auto v: values) {
+        heap.push(static_cast<typename Heap::value_type>(v));
+    }
+    for (int i=0; i<count; i++) {
+        if (heap.pop() != static_cast<typename Heap::value_type>(i)) {
+            return false;
+        }
+    }
+    return heap.empty();
+}
+
+/** Pops every element and returns true if they come out in ascending order */
+template<typename Heap>
+auto drains_in_order(Heap& heap) -> bool {
+    auto previous = heap.pop();
+    while (!heap.empty()) {
+        auto next = heap.pop();
+        if (next < previous) {
+            return false;
+        }
+        previous = next;
+    }
+    return true;
+}
+
+/** Returns the number of allocations made while running f */
+template<typename F>
+auto allocations_during(F f) -> int {
+    auto before = allocation_count;
+    f();
+    return allocation_count - before;
+}
+
 int main() {
     dsc::heap<int, dsc::max_heap> max_heap;
     dsc::heap<int, dsc::min_heap> min_heap;
@@ -37,5 +163,171 @@ int main() {
         std::println("  {}", max_heap.pop());
     }
 
+    std::println("");
+    std::println("Copying, moving and swapping heaps of strings...");
+    auto source = make_heap(100);
+    auto const& const_source = source;
+
+    auto copy = counted_heap{};
+    std::println("Copy from const&      => Expected: 1,   Actual: {}", allocations_during([&] { copy = counted_heap{const_source}; }));
+    std::println("Copy size, front      => Expected: 100 0, Actual: {} {}", copy.size(), copy.front());
+
+    auto moved = counted_heap{};
+    std::println("Move construct        => Expected: 0,   Actual: {}", allocations_during([&] { auto m = std::move(copy); moved = std::move(m); }));
+    std::println("Moved size, source size => Expected: 100 0, Actual: {} {}", moved.size(), copy.size());
+
+    auto target = make_heap(200);
+    std::println("Copy assign into larger heap => Expected: 0, Actual: {}", allocations_during([&] { target = source; }));
+    std::println("Target size, front    => Expected: 100 0, Actual: {} {}", target.size(), target.front());
+
+    auto small = make_heap(3);
+    small.swap(target);
+    std::println("Swap sizes            => Expected: 100 3, Actual: {} {}", small.size(), target.size());
+
+    copy.push("42");
+    std::println("Push onto moved from heap => Expected: 42, Actual: {}", copy.pop());
+
+    std::print("Popping moved heap    => Expected: 0 1 10 11, Actual:");
+    for (int i=0; i<4; i++) {
+        std::print(" {}", moved.pop());
+    }
+    std::println("");
+
+    auto limited   = limited_resource{};
+    limited.budget = 1;
+    auto cramped   = dsc::pmr::heap<std::string, dsc::min_heap>{&limited};
+    cramped.push("kept");
+    auto roomy = dsc::pmr::heap<std::string, dsc::min_heap>{};
+    for (int i=0; i<100; i++) {
+        roomy.push(std::to_string(i));
+    }
+    try {
+        cramped = roomy;
+    } catch (std::bad_alloc const&) {}
+    cramped.push("after");
+    std::println("Push after failed copy assign => Expected: 1 after, Actual: {} {}", cramped.size(), cramped.front());
+
+    // The initial array holds 16, so the 17th push has to grow it and fails
+    limited.budget = 0;
+    for (int i=1; i<16; i++) {
+        cramped.push(std::to_string(i));
+    }
+    try {
+        cramped.push("full");
+    } catch (std::bad_alloc const&) {}
+    std::println("Failed growth keeps elements => Expected: 16 1, Actual: {} {}", cramped.size(), cramped.front());
+
+    std::println("");
+    std::println("Popping 4 and 8-ary heaps...");
+    std::println("4-ary min heap of int      => Expected: true, Actual: {}", pops_in_order<dsc::heap<int, dsc::min_heap, std::allocator<int>, 4>>(1000, g));
+    std::println("8-ary min heap of int      => Expected: true, Actual: {}", pops_in_order<dsc::heap<int, dsc::min_heap, std::allocator<int>, 8>>(1000, g));
+    std::println("8-ary min heap of double   => Expected: true, Actual: {}", pops_in_order<dsc::heap<double, dsc::min_heap, std::allocator<double>, 8>>(1000, g));
+    std::println("3-ary min heap of uint64_t => Expected: true, Actual: {}", pops_in_order<dsc::heap<std::uint64_t, dsc::min_heap, std::allocator<std::uint64_t>, 3>>(1000, g));
+
+    auto wide = dsc::heap<std::string, dsc::max_heap, std::allocator<std::string>, 4>{};
+    for (auto word: {"pear", "apple", "fig", "quince", "kiwi", "banana", "cherry"}) {
+        wide.push(word);
+    }
+    std::print("4-ary max heap of string   => Expected: quince pear kiwi fig cherry banana apple, Actual:");
+    while (!wide.empty()) {
+        std::print(" {}", wide.pop());
+    }
+    std::println("");
+
+    auto aligned = dsc::heap<std::uint64_t, dsc::min_heap, std::allocator<std::uint64_t>, 8>{};
+    auto first_group = reinterpret_cast<std::uintptr_t>(aligned.data() + 1);
+    std::println("Children of the root on one cache line => Expected: 0, Actual: {}", first_group % 64);
+
+    std::println("");
+    std::println("Building heaps from ranges...");
+    auto from_list = dsc::heap<int, dsc::min_heap>{list};
+    std::println("Range constructor size, front => Expected: 100 1, Actual: {} {}", from_list.size(), from_list.front());
+    std::println("Range constructor pops in order => Expected: true, Actual: {}", drains_in_order(from_list));
+
+    auto batched = dsc::heap<int, dsc::min_heap, std::allocator<int>, 4>{};
+    batched.push_range(std::vector<int>{50, 40, 30, 20, 10});
+    batched.push_range(std::vector<int>{5, 45});
+    batched.push_range(std::views::iota(0, 1000) | std::views::filter([](int i) { return i % 7 == 3; }));
+    std::println("push_range size, front => Expected: 150 3, Actual: {} {}", batched.size(), batched.front());
+    std::println("push_range pops in order => Expected: true, Actual: {}", drains_in_order(batched));
+
+    auto words = std::vector<std::string>{"pear", "apple", "fig", "quince", "kiwi"};
+    auto from_words = dsc::heap<std::string, dsc::max_heap>{words};
+    std::println("Range constructor of strings front => Expected: quince, Actual: {}", from_words.front());
+
+    std::println("");
+    std::println("Replacing the top and pushing while popping...");
+    auto scheduler = dsc::heap<int, dsc::min_heap>{std::vector<int>{30, 10, 50, 20, 40}};
+    scheduler.replace_top(35);
+    std::println("replace_top(35) front, size => Expected: 20 5, Actual: {} {}", scheduler.front(), scheduler.size());
+    std::println("push_pop(5) => Expected: 5,  Actual: {}", scheduler.push_pop(5));
+    std::println("push_pop(45) => Expected: 20, Actual: {}", scheduler.push_pop(45));
+    std::print("Remaining   => Expected: 30 35 40 45 50, Actual:");
+    while (!scheduler.empty()) {
+        std::print(" {}", scheduler.pop());
+    }
+    std::println("");
+
+    auto empty = dsc::heap<int, dsc::min_heap>{};
+    std::println("push_pop(7) on empty heap => Expected: 7 0, Actual: {} {}", empty.push_pop(7), empty.size());
+
+    auto tracked_heap = dsc::heap<tracked, dsc::min_heap>{};
+    for (int i=1; i<=15; i++) {
+        tracked_heap.push(i);
+    }
+    std::println("Moves pushing 1..15 in order => Expected: 0, Actual: {}", move_count);
+
+    auto out    = tracked{0};
+    move_count  = 0;
+    out         = tracked_heap.pop();
+    auto by_return = move_count;
+    move_count  = 0;
+    tracked_heap.pop(out);
+    std::println("Moves saved by pop(out) => Expected: 1, Actual: {}", by_return - move_count);
+    std::println("pop(out) value => Expected: 2, Actual: {}", out.value);
+
+    // 100 sinks to the bottom of 4 levels: one move up per level it passes and one into the final hole
+    move_count = 0;
+    tracked_heap.replace_top(100);
+    std::println("Moves for replace_top sinking 3 levels => Expected: 4, Actual: {}", move_count);
+
+    std::println("");
+    std::println("Ordering structs by a member, a stateful comparator and a cached key...");
+    auto tasks = std::vector<task>{{30, "backup"}, {10, "email"}, {20, "deploy"}, {5, "page"}};
+
+    auto by_deadline = dsc::heap<task, dsc::order_by<&task::deadline>>{tasks};
+    std::print("order_by<&task::deadline> => Expected: page email deploy backup, Actual:");
+    while (!by_deadline.empty()) {
+        std::print(" {}", by_deadline.pop().name);
+    }
+    std::println("");
+
+    auto by_name = dsc::heap<task, dsc::order_by<&task::name_length, std::greater<>>, std::allocator<task>, 4>{tasks};
+    std::println("Longest name on top       => Expected: backup, Actual: {}", by_name.front().name);
+
+    // Orders by distance from a target chosen at run time
+    auto goal    = 17;
+    auto closest = [goal](int a, int b) { return std::abs(a - goal) < std::abs(b - goal); };
+    using near_order = dsc::heap_order<decltype(closest)>;
+    auto near = dsc::heap<int, near_order>{std::vector<int>{1, 30, 15, 22, 16}, near_order{closest}};
+    std::print("Closest to 17 first       => Expected: 16 15 22 30 1, Actual:");
+    while (!near.empty()) {
+        std::print(" {}", near.pop());
+    }
+    std::println("");
+
+    auto cached = dsc::cached_key_heap<task, counted_deadline>{};
+    for (auto const& t: tasks) {
+        cached.push(t);
+    }
+    cached.push_pop(task{25, "report"});
+    cached.replace_top(task{40, "archive"});
+    std::print("cached_key_heap           => Expected: deploy report backup archive, Actual:");
+    while (!cached.empty()) {
+        std::print(" {}", cached.pop().name);
+    }
+    std::println("");
+    std::println("Projections run         => Expected: 6, Actual: {}", projections);
+
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,129 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <bit>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <dsc/heap.hpp>
+#include <dsc/hugepage_allocator.hpp>
+#include <dsc/ring_vector.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const READS     = 1 << 24;
+auto const HEAP_SIZE = 1 << 24;
+auto const POPS      = 1 << 22;
+
+/** Returns the next value of a 64 bit linear congruential generator, cheap enough not to hide memory latency */
+auto lcg(std::uint64_t& state) -> std::uint64_t {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return state >> 16;
+}
+
+/** Prints how much anonymous memory of this process is backed by transparent huge pages */
+auto print_huge_pages() -> void {
+    auto smaps = std::ifstream{"/proc/self/smaps_rollup"};
+    auto line  = std::string{};
+    while (std::getline(smaps, line)) {
+        if (line.starts_with("AnonHugePages:")) {
+            cout << "   " << line << "\n";
+        }
+    }
+}
+
+/** Times random operator[] reads over a full, wrapped ring vector of the given size in bytes */
+template<typename Allocator>
+auto time_random_reads(std::size_t bytes) -> void {
+    auto const count = bytes / sizeof(std::uint64_t);
+    auto vec         = dsc::ring_vector<std::uint64_t, Allocator>{count};
+    for (std::size_t i=0; i<count/4; i++) {
+        vec.push_front(i);
+    }
+    for (std::size_t i=count/4; i<count; i++) {
+        vec.push_back(i);
+    }
+    print_huge_pages();
+
+    auto state = std::uint64_t{42};
+    auto sum   = std::uint64_t{0};
+    auto start = timer::now();
+    for (auto i=0; i<READS; i++) {
+        sum += vec[lcg(state) & (count - 1)];
+    }
+    auto ns = std::chrono::duration<double, std::nano>(timer::now() - start).count();
+    cout << "   Random reads: " << (ns / READS) << " ns each (checksum " << sum << ")\n";
+}
+
+/** Times pops from a min heap of HEAP_SIZE random values */
+template<typename Allocator>
+auto time_heap_pops() -> void {
+    auto heap  = dsc::heap<std::uint64_t, dsc::min_heap, Allocator>{};
+    auto state = std::uint64_t{42};
+    for (auto i=0; i<HEAP_SIZE; i++) {
+        heap.push(lcg(state));
+    }
+    print_huge_pages();
+
+    auto sum   = std::uint64_t{0};
+    auto start = timer::now();
+    for (auto i=0; i<POPS; i++) {
+        sum += heap.pop();
+    }
+    auto seconds = std::chrono::duration<double>(timer::now() - start).count();
+    cout << "   Heap pops: " << (POPS / seconds / 1e6) << " M per second (checksum " << sum << ")\n";
+}
+
+/** Runs f in a child process so each case starts from a fresh address space */
+template<typename F>
+auto run_case(std::string const& name, F f) -> void {
+    cout << name << "\n";
+    cout.flush();
+
+    auto pid = fork();
+    if (pid == 0) {
+        f();
+        cout.flush();
+        std::_Exit(0);
+    }
+    waitpid(pid, nullptr, 0);
+    cout << "\n";
+}
+
+
+/** Sizes of the ring vector are given in MB on the command line, defaulting to 1 GB. Sizes are rounded down to a
+ *  power of 2. */
+auto main(int argc, char *argv[]) -> int {
+    auto sizes = std::vector<std::size_t>{};
+    for (auto i=1; i<argc; i++) {
+        sizes.push_back(std::bit_floor(static_cast<std::size_t>(std::atoll(argv[i]))) << 20);
+    }
+    if (sizes.empty()) {
+        sizes = {std::size_t{1} << 30};
+    }
+
+    for (auto bytes: sizes) {
+        auto mb = std::to_string(bytes >> 20);
+        run_case("std::allocator, " + mb + " MB ring_vector<uint64_t>", [=] {
+            time_random_reads<std::allocator<std::uint64_t>>(bytes);
+        });
+        run_case("dsc::hugepage_allocator, " + mb + " MB ring_vector<uint64_t>", [=] {
+            time_random_reads<dsc::hugepage_allocator<std::uint64_t>>(bytes);
+        });
+    }
+
+    run_case("std::allocator, heap of " + std::to_string(HEAP_SIZE) + " uint64_t", [] {
+        time_heap_pops<std::allocator<std::uint64_t>>();
+    });
+    run_case("dsc::hugepage_allocator, heap of " + std::to_string(HEAP_SIZE) + " uint64_t", [] {
+        time_heap_pops<dsc::hugepage_allocator<std::uint64_t>>();
+    });
+}
@@ -0,0 +1,142 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <deque>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <memory_resource>
+#include <utility>
+
+#include "dsc/incremental_ring_vector.hpp"
+
+/** Allocator which throws std::bad_alloc once a shared budget of allocations is used up */
+template<typename T>
+struct limited_allocator {
+    using value_type = T;
+
+    static inline int budget = 0;
+
+    limited_allocator() = default;
+    template<typename U>
+    limited_allocator(limited_allocator<U> const&) {}
+
+    auto allocate(size_t n) -> T* {
+        if (budget-- <= 0) {
+            throw std::bad_alloc{};
+        }
+        return std::allocator<T>{}.allocate(n);
+    }
+    auto deallocate(T* p, size_t n) -> void { std::allocator<T>{}.deallocate(p, n); }
+
+    friend auto operator==(limited_allocator const&, limited_allocator const&) -> bool { return true; }
+};
+
+int main() {
+    std::cout << "Pushing 1..20 onto back of incremental ring vector...\n";
+    auto vec = dsc::incremental_ring_vector<std::string>{};
+    for (int i=1; i<=20; i++) {
+        vec.push_back(std::to_string(i));
+        std::cout << "Size: " << vec.size() << ", Capacity: " << vec.capacity()
+                  << ", Migrating: " << (vec.migrating() ? "true" : "false") << "\n";
+    }
+
+    std::cout << "Values: ";
+    for (auto& v: vec) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n\n";
+
+    std::cout << "Running 100000 random push/pop operations on both ends against std::deque...\n";
+    auto rd      = std::random_device{};
+    auto gen     = std::mt19937{rd()};
+    auto next_op = std::uniform_int_distribution<>(0, 5);
+    auto ints    = dsc::incremental_ring_vector<int>{};
+    auto check   = std::deque<int>{};
+    auto errors  = 0;
+
+    for (int i=0; i<100000; i++) {
+        auto op = next_op(gen);
+        if (op < 2 || check.empty()) {
+            ints.push_back(i);
+            check.push_back(i);
+        } else if (op < 4) {
+            ints.push_front(i);
+            check.push_front(i);
+        } else if (op == 4) {
+            errors += ints.pop_back_get() != check.back();
+            check.pop_back();
+        } else {
+            errors += ints.pop_front_get() != check.front();
+            check.pop_front();
+        }
+
+        if (!check.empty()) {
+            auto pos = static_cast<size_t>(i) % check.size();
+            errors += ints[pos] != check[pos];
+        }
+    }
+
+    std::cout << "Size:     " << ints.size() << ", Expected: " << check.size() << "\n";
+    std::cout << "Capacity: " << ints.capacity() << "\n";
+    std::cout << "Errors => Expected: 0, Actual: " << errors << "\n\n";
+
+    std::cout << "Copying and moving vector while migrating...\n";
+    auto copied = ints;
+    auto moved  = std::move(ints);
+    auto same   = copied.size() == moved.size();
+    for (size_t i=0; same && i<copied.size(); i++) {
+        same = copied[i] == moved[i];
+    }
+    std::cout << "Copy equals move => Expected: true, Actual: " << (same ? "true" : "false") << "\n";
+    std::cout << "Moved from size  => Expected: 0,    Actual: " << ints.size() << "\n";
+
+    std::cout << "\nGrowing past a failing allocation...\n";
+    limited_allocator<std::string>::budget = 1;
+    auto limited = dsc::incremental_ring_vector<std::string, limited_allocator<std::string>>{};
+    for (int i=1; i<=4; i++) {
+        limited.push_back(std::to_string(i));
+    }
+    try {
+        limited.push_back("5");
+        std::cout << "Push => Expected: bad_alloc, Actual: no error\n";
+    } catch (std::bad_alloc const&) {
+        std::cout << "Push => Expected: bad_alloc, Actual: bad_alloc\n";
+    }
+    std::cout << "Size, capacity => Expected: 4 4, Actual: " << limited.size() << " " << limited.capacity() << "\n";
+    std::cout << "Values => Expected: 1 2 3 4, Actual: ";
+    for (auto& v: limited) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+
+    std::cout << "\nMoving and swapping pmr containers across memory resources...\n";
+    auto arena_a = std::pmr::monotonic_buffer_resource{};
+    auto arena_b = std::pmr::monotonic_buffer_resource{};
+    auto in_a    = dsc::pmr::incremental_ring_vector<std::string>{&arena_a};
+    for (int i=1; i<=6; i++) {
+        in_a.push_back(std::to_string(i));
+    }
+    auto copy_of_a  = in_a;
+    auto moved_of_a = std::move(in_a);
+    auto in_b       = dsc::pmr::incremental_ring_vector<std::string>{&arena_b};
+    in_b = std::move(moved_of_a);
+    auto resource_name = [&](auto const& container) {
+        auto* resource = container.get_allocator().resource();
+        return resource == &arena_a ? "a" : resource == &arena_b ? "b" : "default";
+    };
+    std::cout << "Copy resource          => Expected: default, Actual: " << resource_name(copy_of_a) << "\n";
+    std::cout << "Move resource          => Expected: a,       Actual: " << resource_name(moved_of_a) << "\n";
+    std::cout << "Move assigned resource => Expected: b,       Actual: " << resource_name(in_b) << "\n";
+    std::cout << "Moved from size        => Expected: 0,       Actual: " << moved_of_a.size() << "\n";
+    auto other_b = dsc::pmr::incremental_ring_vector<std::string>{&arena_b};
+    other_b.push_back("x");
+    other_b.swap(in_b);
+    std::cout << "Swapped sizes          => Expected: 1 6,     Actual: " << in_b.size() << " " << other_b.size() << "\n";
+    std::cout << "Values => Expected: 1 2 3 4 5 6, Actual: ";
+    for (auto& v: other_b) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+}
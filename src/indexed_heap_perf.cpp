@@ -0,0 +1,128 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <dsc/heap.hpp>
+#include <dsc/indexed_heap.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const NODES          = 1 << 20;
+auto const EDGES_PER_NODE = 16;
+auto const INFINITE       = std::numeric_limits<std::uint64_t>::max();
+
+/** Graph in compressed sparse row form: the edges of node n are targets[offsets[n]] to targets[offsets[n+1]-1] */
+struct graph {
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> targets;
+    std::vector<std::uint32_t> weights;
+};
+
+/** Builds a random graph where every node has EDGES_PER_NODE outgoing edges with weights from 1 to 1000 */
+auto make_graph() -> graph {
+    auto g     = graph{};
+    auto state = std::uint64_t{42};
+    auto next  = [&] {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<std::uint32_t>(state >> 33);
+    };
+
+    g.offsets.reserve(NODES + 1);
+    for (auto n=0; n<NODES; n++) {
+        g.offsets.push_back(static_cast<std::uint32_t>(g.targets.size()));
+        for (auto e=0; e<EDGES_PER_NODE; e++) {
+            g.targets.push_back(next() % NODES);
+            g.weights.push_back(next() % 1000 + 1);
+        }
+    }
+    g.offsets.push_back(static_cast<std::uint32_t>(g.targets.size()));
+    return g;
+}
+
+/** Prints the time elapsed since start in seconds */
+auto print_elapsed(timer::time_point start) {
+    auto end = timer::now();
+    cout << "   Elapsed time: " << (std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count()/1000.0) << "\n";
+}
+
+/** Dijkstra with lazy deletion: a shorter distance pushes a duplicate, and stale entries are skipped when popped */
+auto lazy_dijkstra(graph const& g) -> std::vector<std::uint64_t> {
+    auto dist   = std::vector<std::uint64_t>(NODES, INFINITE);
+    auto queue  = dsc::heap<std::pair<std::uint64_t, std::uint32_t>, dsc::min_heap>{};
+    auto peak   = std::size_t{0};
+    auto stale  = std::size_t{0};
+
+    dist[0] = 0;
+    queue.push(0, 0);
+    while (!queue.empty()) {
+        peak = std::max(peak, queue.size());
+        auto [d, node] = queue.pop();
+        if (d != dist[node]) {
+            stale++;
+            continue;
+        }
+        for (auto e=g.offsets[node]; e<g.offsets[node+1]; e++) {
+            auto target = g.targets[e];
+            if (d + g.weights[e] < dist[target]) {
+                dist[target] = d + g.weights[e];
+                queue.push(dist[target], target);
+            }
+        }
+    }
+    cout << "   Peak heap size: " << peak << ", stale entries popped: " << stale << "\n";
+    return dist;
+}
+
+/** Dijkstra with an indexed heap: a shorter distance lowers the queued entry in place with decrease_key */
+auto indexed_dijkstra(graph const& g) -> std::vector<std::uint64_t> {
+    using queue_t = dsc::indexed_heap<std::pair<std::uint64_t, std::uint32_t>, dsc::min_heap>;
+    auto dist     = std::vector<std::uint64_t>(NODES, INFINITE);
+    auto handles  = std::vector<queue_t::handle>(NODES);
+    auto queue    = queue_t{};
+    auto peak     = std::size_t{0};
+
+    dist[0]    = 0;
+    handles[0] = queue.push(0, 0);
+    while (!queue.empty()) {
+        peak = std::max(peak, queue.size());
+        auto [d, node] = queue.pop();
+        for (auto e=g.offsets[node]; e<g.offsets[node+1]; e++) {
+            auto target = g.targets[e];
+            if (d + g.weights[e] < dist[target]) {
+                auto first_visit = dist[target] == INFINITE;
+                dist[target] = d + g.weights[e];
+                if (first_visit) {
+                    handles[target] = queue.push(dist[target], target);
+                } else {
+                    queue.decrease_key(handles[target], std::pair{dist[target], target});
+                }
+            }
+        }
+    }
+    cout << "   Peak heap size: " << peak << ", stale entries popped: 0\n";
+    return dist;
+}
+
+auto main() -> int {
+    cout << "Building random graph of " << NODES << " nodes and " << NODES * EDGES_PER_NODE << " edges...\n";
+    auto g = make_graph();
+
+    cout << "Dijkstra on dsc::heap with duplicate pushes...\n";
+    auto start = timer::now();
+    auto lazy  = lazy_dijkstra(g);
+    print_elapsed(start);
+
+    cout << "Dijkstra on dsc::indexed_heap with decrease_key...\n";
+    start        = timer::now();
+    auto indexed = indexed_dijkstra(g);
+    print_elapsed(start);
+
+    cout << "Same distances => Expected: true, Actual: " << (lazy == indexed ? "true" : "false") << "\n";
+}
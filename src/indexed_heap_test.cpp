@@ -0,0 +1,101 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <array>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dsc/indexed_heap.hpp"
+
+int main() {
+    std::cout << "Pushing 50 40 30 20 10 onto an indexed min heap and changing keys through handles...\n";
+    auto heap    = dsc::indexed_heap<int, dsc::min_heap>{};
+    auto handles = std::vector<dsc::indexed_heap<int, dsc::min_heap>::handle>{};
+    for (int v: {50, 40, 30, 20, 10}) {
+        handles.push_back(heap.push(v));
+    }
+    std::cout << "top()                  => Expected: 10, Actual: " << heap.top() << "\n";
+
+    heap.decrease_key(handles[0], 5);
+    std::cout << "decrease_key(50 -> 5)  => Expected: 5,  Actual: " << heap.top() << "\n";
+    std::cout << "top_handle() is 50's   => Expected: true, Actual: " << (heap.top_handle() == handles[0] ? "true" : "false") << "\n";
+
+    heap.increase_key(handles[0], 45);
+    std::cout << "increase_key(5 -> 45)  => Expected: 10, Actual: " << heap.top() << "\n";
+
+    heap.update(handles[2], 1);
+    std::cout << "update(30 -> 1)        => Expected: 1,  Actual: " << heap.top() << "\n";
+    heap.modify(handles[2], [](int& v) { v = 35; });
+    std::cout << "modify(1 -> 35)        => Expected: 10, Actual: " << heap.top() << "\n";
+
+    heap.erase(handles[4]);
+    std::cout << "erase(10) top, size    => Expected: 20 4, Actual: " << heap.top() << " " << heap.size() << "\n";
+    std::cout << "contains(erased)       => Expected: false, Actual: " << (heap.contains(handles[4]) ? "true" : "false") << "\n";
+    std::cout << "heap[handles[1]]       => Expected: 40, Actual: " << heap[handles[1]] << "\n";
+
+    std::cout << "Popping  => Expected: 20 35 40 45, Actual: ";
+    while (!heap.empty()) {
+        std::cout << heap.pop() << " ";
+    }
+    std::cout << "\n\n";
+
+    std::cout << "Reusing ids after pops on a max heap of strings...\n";
+    auto words      = dsc::indexed_heap<std::string, dsc::max_heap, std::allocator<std::string>, 4>{};
+    auto pear       = words.push("pear");
+    words.push("apple");
+    words.push("fig");
+    words.pop();
+    auto quince     = words.push("quince");
+    words.update(quince, "banana");
+    std::cout << "Reused id of popped element => Expected: true, Actual: " << (quince == pear ? "true" : "false") << "\n";
+    std::cout << "Popping  => Expected: fig banana apple, Actual: ";
+    while (!words.empty()) {
+        std::cout << words.pop() << " ";
+    }
+    std::cout << "\n\n";
+
+    std::cout << "Shortest paths from node 0 with Dijkstra...\n";
+    // Edges as {from, to, weight}
+    auto const edges = std::array<std::array<int, 3>, 9>{{
+        {0, 1, 7}, {0, 2, 9}, {0, 5, 14}, {1, 2, 10}, {1, 3, 15}, {2, 3, 11}, {2, 5, 2}, {3, 4, 6}, {4, 5, 9},
+    }};
+    auto const infinity = std::numeric_limits<int>::max();
+    using dist_heap     = dsc::indexed_heap<std::pair<int, int>, dsc::min_heap>;
+    auto queue          = dist_heap{};
+    auto dist           = std::array<int, 6>{0, infinity, infinity, infinity, infinity, infinity};
+    auto queued         = std::array<dist_heap::handle, 6>{};
+    auto in_queue       = std::array<bool, 6>{};
+    auto decreases      = 0;
+
+    queued[0]   = queue.push(0, 0);
+    in_queue[0] = true;
+    while (!queue.empty()) {
+        auto [d, node]  = queue.pop();
+        in_queue[node]  = false;
+        for (auto [from, to, weight]: edges) {
+            for (auto [a, b]: {std::pair{from, to}, std::pair{to, from}}) {
+                if (a != node || d + weight >= dist[b]) {
+                    continue;
+                }
+                dist[b] = d + weight;
+                if (in_queue[b]) {
+                    queue.decrease_key(queued[b], std::pair{dist[b], b});
+                    decreases++;
+                } else {
+                    queued[b]   = queue.push(dist[b], b);
+                    in_queue[b] = true;
+                }
+            }
+        }
+    }
+    std::cout << "Distances => Expected: 0 7 9 20 20 11, Actual: ";
+    for (auto d: dist) {
+        std::cout << d << " ";
+    }
+    std::cout << "\n";
+    std::cout << "decrease_key calls => Expected: 2, Actual: " << decreases << "\n";
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <dsc/heap.hpp>
+#include <dsc/kway_merge.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const ELEMENTS = std::size_t{1} << 24;
+auto const STRINGS  = std::size_t{1} << 22;
+
+auto comparison_count = 0ll;
+
+/** std::less<> which counts every call in comparison_count */
+struct counting_less {
+    auto operator()(std::uint64_t a, std::uint64_t b) const -> bool {
+        comparison_count++;
+        return a < b;
+    }
+};
+
+/** std::less<> on strings which counts every call in comparison_count */
+struct counting_string_less {
+    auto operator()(std::string const& a, std::string const& b) const -> bool {
+        comparison_count++;
+        return a < b;
+    }
+};
+
+/** Returns count random keys made by make_key, split into k sorted runs */
+template<typename F>
+auto make_runs(std::size_t k, std::size_t count, F make_key) {
+    auto runs  = std::vector<std::vector<decltype(make_key(0ull))>>(k);
+    auto state = std::uint64_t{42};
+    for (std::size_t i=0; i<count; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        runs[i % k].push_back(make_key(state >> 16));
+    }
+    for (auto& run: runs) {
+        std::ranges::sort(run);
+    }
+    return runs;
+}
+
+/** Returns value as a key with a long common prefix, like the sorted ids of one table */
+auto string_key(std::uint64_t value) -> std::string {
+    auto digits = std::to_string(value % 1'000'000'000'000);
+    return "customer/orders/" + std::string(12 - digits.size(), '0') + digits;
+}
+
+/** Head of a run as pushed onto dsc::heap by a hand written merge */
+struct head {
+    std::uint64_t value;
+    std::size_t   run;
+
+    auto operator<=>(head const& other) const { return value <=> other.value; }
+    auto operator==(head const& other) const -> bool { return value == other.value; }
+};
+
+/** Merges runs the way callers did before kway_merge: pop the smallest head and push the next element of its run */
+auto pop_push_merge(std::vector<std::vector<std::uint64_t>> const& runs) -> std::uint64_t {
+    auto heap = dsc::heap<head, dsc::min_heap>{};
+    auto next = std::vector<std::size_t>(runs.size(), 1);
+    for (std::size_t r=0; r<runs.size(); r++) {
+        heap.push(head{runs[r][0], r});
+    }
+    auto sum = std::uint64_t{0};
+    while (!heap.empty()) {
+        auto top = heap.pop();
+        sum = sum * 31 + top.value;
+        if (next[top.run] < runs[top.run].size()) {
+            heap.push(head{runs[top.run][next[top.run]++], top.run});
+        }
+    }
+    return sum;
+}
+
+/** Drains a kway_merge over runs with Strategy and comparator Compare, returning a checksum */
+template<dsc::merge_strategy Strategy, typename Compare = std::less<>, typename Runs>
+auto kway(Runs const& runs) -> std::uint64_t {
+    auto sum = std::uint64_t{0};
+    for (auto const& v: dsc::kway_merge<Runs const, Compare, Strategy>{runs}) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(v)>, std::string>) {
+            sum = sum * 31 + v.back();
+        } else {
+            sum = sum * 31 + v;
+        }
+    }
+    return sum;
+}
+
+/** Times merge over runs of count elements and prints nanoseconds per element */
+template<typename F, typename Runs>
+auto time_merge(char const* name, F merge, Runs const& runs, std::size_t count) -> std::uint64_t {
+    auto start   = timer::now();
+    auto sum     = merge(runs);
+    auto seconds = std::chrono::duration<double>(timer::now() - start).count();
+    cout << "   " << name << ": " << (seconds * 1e9 / count) << " ns per element";
+    return sum;
+}
+
+/** Prints comparisons per element made by merge over runs of count elements */
+template<typename F, typename Runs>
+auto count_merge(F merge, Runs const& runs, std::size_t count) -> void {
+    comparison_count = 0;
+    merge(runs);
+    cout << ", " << static_cast<double>(comparison_count) / count << " comparisons per element\n";
+}
+
+auto main() -> int {
+    for (std::size_t k=2; k<=1024; k*=2) {
+        cout << "Merging " << ELEMENTS << " 64 bit keys from " << k << " sorted runs...\n";
+        auto runs = make_runs(k, ELEMENTS, [](std::uint64_t v) { return v; });
+
+        using u64 = std::vector<std::vector<std::uint64_t>>;
+        auto a = time_merge("dsc::heap pop() and push()", pop_push_merge, runs, ELEMENTS);
+        cout << "\n";
+        auto b = time_merge("kway_merge heap           ", kway<dsc::merge_strategy::heap, std::less<>, u64>, runs, ELEMENTS);
+        count_merge(kway<dsc::merge_strategy::heap, counting_less, u64>, runs, ELEMENTS);
+        auto c = time_merge("kway_merge loser tree     ", kway<dsc::merge_strategy::loser_tree, std::less<>, u64>, runs, ELEMENTS);
+        count_merge(kway<dsc::merge_strategy::loser_tree, counting_less, u64>, runs, ELEMENTS);
+        cout << "   Same output => Expected: true, Actual: " << (a == b && b == c ? "true" : "false") << "\n";
+    }
+
+    for (std::size_t k=2; k<=1024; k*=8) {
+        cout << "Merging " << STRINGS << " string keys with a 16 character common prefix from " << k << " sorted runs...\n";
+        auto runs = make_runs(k, STRINGS, string_key);
+
+        using str = std::vector<std::vector<std::string>>;
+        auto b = time_merge("kway_merge heap      ", kway<dsc::merge_strategy::heap, std::less<>, str>, runs, STRINGS);
+        count_merge(kway<dsc::merge_strategy::heap, counting_string_less, str>, runs, STRINGS);
+        auto c = time_merge("kway_merge loser tree", kway<dsc::merge_strategy::loser_tree, std::less<>, str>, runs, STRINGS);
+        count_merge(kway<dsc::merge_strategy::loser_tree, counting_string_less, str>, runs, STRINGS);
+        cout << "   Same output => Expected: true, Actual: " << (b == c ? "true" : "false") << "\n";
+    }
+}
@@ -0,0 +1,123 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dsc/kway_merge.hpp"
+#include "dsc/ring_vector.hpp"
+
+/** Returns k sorted runs of random lengths up to max_length, with values drawn from a small range so runs share
+ *  values */
+auto random_runs(std::size_t k, std::size_t max_length, std::uint64_t seed) -> std::vector<std::vector<int>> {
+    auto runs = std::vector<std::vector<int>>(k);
+    for (auto& run: runs) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        run.resize((seed >> 33) % (max_length + 1));
+        for (auto& v: run) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            v    = static_cast<int>((seed >> 33) % 1000);
+        }
+        std::ranges::sort(run);
+    }
+    return runs;
+}
+
+/** Returns true if merging runs with Strategy gives the same elements as sorting them all */
+template<dsc::merge_strategy Strategy>
+auto matches_sort(std::vector<std::vector<int>>& runs) -> bool {
+    auto expected = std::vector<int>{};
+    for (auto const& run: runs) {
+        expected.insert(expected.end(), run.begin(), run.end());
+    }
+    std::ranges::sort(expected);
+
+    auto merged = std::vector<int>{};
+    for (auto v: dsc::kway_merge<std::vector<std::vector<int>>, std::less<>, Strategy>{runs}) {
+        merged.push_back(v);
+    }
+    return merged == expected;
+}
+
+int main() {
+    std::cout << "Merging {1 4 7} {2 5 8} {} {0 3 6 9}...\n";
+    auto runs = std::vector<std::vector<int>>{{1, 4, 7}, {2, 5, 8}, {}, {0, 3, 6, 9}};
+    std::cout << "Merged => Expected: 0 1 2 3 4 5 6 7 8 9, Actual: ";
+    for (auto v: dsc::kway_merge{runs}) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+
+    auto tree = dsc::kway_merge{runs};
+    std::cout << "runs() front() => Expected: 4 0, Actual: " << tree.runs() << " " << tree.front() << "\n";
+    std::cout << "Default strategy for ints is the heap => Expected: true, Actual: "
+              << (std::is_same_v<decltype(tree), dsc::kway_merge<decltype(runs), std::less<>, dsc::merge_strategy::heap>> ? "true" : "false") << "\n";
+    auto none = std::vector<std::vector<int>>{};
+    std::cout << "No runs empty() => Expected: true, Actual: " << (dsc::kway_merge{none}.empty() ? "true" : "false") << "\n\n";
+
+    std::cout << "Random runs against std::sort for k = 1 to 33 with both strategies...\n";
+    auto tree_ok = true;
+    auto heap_ok = true;
+    for (auto k=1u; k<=33; k++) {
+        auto random = random_runs(k, 50, k);
+        tree_ok &= matches_sort<dsc::merge_strategy::loser_tree>(random);
+        heap_ok &= matches_sort<dsc::merge_strategy::heap>(random);
+    }
+    std::cout << "Loser tree matches => Expected: true, Actual: " << (tree_ok ? "true" : "false") << "\n";
+    std::cout << "Heap matches       => Expected: true, Actual: " << (heap_ok ? "true" : "false") << "\n\n";
+
+    std::cout << "Equal keys keep the order of their runs...\n";
+    using item = std::pair<int, char>;
+    auto by_key  = [](item const& a, item const& b) { return a.first < b.first; };
+    auto labeled = std::vector<std::vector<item>>{{{1, 'a'}, {2, 'a'}}, {{1, 'b'}, {2, 'b'}}, {{1, 'c'}}};
+    std::cout << "Loser tree => Expected: a b c a b, Actual: ";
+    for (auto const& [key, label]: dsc::kway_merge{labeled, by_key}) {
+        std::cout << label << " ";
+    }
+    std::cout << "\n";
+    std::cout << "Heap       => Expected: a b c a b, Actual: ";
+    for (auto const& [key, label]: dsc::kway_merge<decltype(labeled), decltype(by_key), dsc::merge_strategy::heap>{labeled, by_key}) {
+        std::cout << label << " ";
+    }
+    std::cout << "\n\n";
+
+    std::cout << "Merging descending ring_vector buffers and a std::list...\n";
+    auto buffers = std::vector<dsc::ring_vector<int>>(3);
+    for (auto v: {9, 6, 3}) buffers[0].push_back(v);
+    for (auto v: {8, 5, 2}) buffers[1].push_back(v);
+    for (auto v: {1, 4, 7}) buffers[2].push_front(v);
+    std::cout << "ring_vector runs => Expected: 9 8 7 6 5 4 3 2 1, Actual: ";
+    for (auto v: dsc::kway_merge{buffers, std::greater<>{}}) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+
+    auto lists = std::vector<std::list<std::string>>{{"apple", "melon"}, {"banana", "kiwi"}};
+    auto words = dsc::kway_merge{lists};
+    std::cout << "Default strategy for strings is the loser tree => Expected: true, Actual: "
+              << (std::is_same_v<decltype(words), dsc::kway_merge<decltype(lists), std::less<>, dsc::merge_strategy::loser_tree>> ? "true" : "false") << "\n";
+    std::cout << "list runs        => Expected: apple banana kiwi melon, Actual: ";
+    for (auto const& s: words) {
+        std::cout << s << " ";
+    }
+    std::cout << "\n\n";
+
+    std::cout << "Merging single pass input runs...\n";
+    auto first  = std::istringstream{"1 3 5"};
+    auto second = std::istringstream{"2 4 6"};
+    auto inputs = std::vector{std::views::istream<int>(first), std::views::istream<int>(second)};
+    std::cout << "Merged => Expected: 1 2 3 4 5 6, Actual: ";
+    for (auto v: dsc::kway_merge{inputs}) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <dsc/heap.hpp>
+#include <dsc/minmax_heap.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const OPERATIONS = 20'000'000;
+auto const BACKLOG    = 1'000'000;
+
+/** Returns the next value of a 64 bit linear congruential generator */
+auto lcg(std::uint64_t& state) -> std::uint64_t {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return state >> 16;
+}
+
+/** Prints the time elapsed since start in seconds */
+auto print_elapsed(timer::time_point start) {
+    auto end = timer::now();
+    cout << "   Elapsed time: " << (std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count()/1000.0) << "\n";
+}
+
+/** Admission control on one minmax_heap: requests arrive with random priorities, the best is admitted and, once the
+ *  backlog is full, the worst is shed */
+auto admit_minmax() -> std::uint64_t {
+    auto queue = dsc::minmax_heap<std::uint64_t>{};
+    auto state = std::uint64_t{42};
+    auto sum   = std::uint64_t{0};
+    auto peak  = std::size_t{0};
+
+    for (auto i=0; i<OPERATIONS; i++) {
+        queue.push(lcg(state));
+        if (i % 2 == 1) {
+            sum += queue.pop_min();
+        }
+        if (queue.size() > BACKLOG) {
+            sum -= queue.pop_max();
+        }
+        peak = std::max(peak, queue.size());
+    }
+    cout << "   Peak stored elements: " << peak << "\n";
+    return sum;
+}
+
+/** The same workload on a min heap and a max heap of (priority, id) pairs. An element removed from one heap is marked
+ *  dead by id and skipped when it reaches the top of the other. */
+auto admit_two_heaps() -> std::uint64_t {
+    using entry = std::pair<std::uint64_t, std::uint32_t>;
+    auto low    = dsc::heap<entry, dsc::min_heap>{};
+    auto high   = dsc::heap<entry, dsc::max_heap>{};
+    auto dead   = std::vector<bool>(OPERATIONS);
+    auto state  = std::uint64_t{42};
+    auto sum    = std::uint64_t{0};
+    auto live   = std::size_t{0};
+    auto peak   = std::size_t{0};
+
+    auto pop_live = [&](auto& heap) {
+        while (dead[heap.front().second]) {
+            heap.pop();
+        }
+        auto [priority, id] = heap.pop();
+        dead[id] = true;
+        live--;
+        return priority;
+    };
+
+    for (auto i=0; i<OPERATIONS; i++) {
+        auto priority = lcg(state);
+        low.push(priority, static_cast<std::uint32_t>(i));
+        high.push(priority, static_cast<std::uint32_t>(i));
+        live++;
+        if (i % 2 == 1) {
+            sum += pop_live(low);
+        }
+        if (live > BACKLOG) {
+            sum -= pop_live(high);
+        }
+        peak = std::max(peak, low.size() + high.size());
+    }
+    cout << "   Peak stored elements: " << peak << "\n";
+    return sum;
+}
+
+auto main() -> int {
+    cout << "Admission control of " << OPERATIONS << " requests with a backlog of " << BACKLOG << " on dsc::minmax_heap...\n";
+    auto start   = timer::now();
+    auto minmax  = admit_minmax();
+    print_elapsed(start);
+
+    cout << "The same on a dsc::heap min heap and max heap with lazy deletion...\n";
+    start        = timer::now();
+    auto two     = admit_two_heaps();
+    print_elapsed(start);
+
+    cout << "Same admissions => Expected: true, Actual: " << (minmax == two ? "true" : "false") << "\n";
+}
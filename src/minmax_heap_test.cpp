@@ -0,0 +1,106 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "dsc/minmax_heap.hpp"
+
+int main() {
+    std::cout << "Pushing 50 10 40 20 30 60 onto a minmax heap...\n";
+    auto heap = dsc::minmax_heap<int>{};
+    for (int v: {50, 10, 40, 20, 30, 60}) {
+        heap.push(v);
+    }
+    std::cout << "min() max() size() => Expected: 10 60 6, Actual: " << heap.min() << " " << heap.max() << " "
+              << heap.size() << "\n";
+    std::cout << "pop_min()          => Expected: 10, Actual: " << heap.pop_min() << "\n";
+    std::cout << "pop_max()          => Expected: 60, Actual: " << heap.pop_max() << "\n";
+    std::cout << "min() max()        => Expected: 20 50, Actual: " << heap.min() << " " << heap.max() << "\n";
+    std::cout << "Alternating pops   => Expected: 20 50 30 40, Actual: ";
+    while (!heap.empty()) {
+        std::cout << heap.pop_min() << " ";
+        if (!heap.empty()) {
+            std::cout << heap.pop_max() << " ";
+        }
+    }
+    std::cout << "\n";
+
+    heap.push(7);
+    std::cout << "One element min() max() => Expected: 7 7, Actual: " << heap.min() << " " << heap.max() << "\n";
+    std::cout << "pop_max() of one        => Expected: 7 true, Actual: " << heap.pop_max() << " "
+              << (heap.empty() ? "true" : "false") << "\n\n";
+
+    std::cout << "Random pushes and pops against a sorted std::vector...\n";
+    auto mixed     = dsc::minmax_heap<std::uint32_t>{4};
+    auto reference = std::vector<std::uint32_t>{};
+    auto state     = std::uint64_t{42};
+    auto mismatches = 0;
+    for (auto i=0; i<20000; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        auto r = static_cast<std::uint32_t>(state >> 33);
+        if (r % 3 != 0 || reference.empty()) {
+            mixed.push(r % 1000);
+            reference.insert(std::ranges::upper_bound(reference, r % 1000), r % 1000);
+        } else if (r % 2 == 0) {
+            mismatches += mixed.pop_min() != reference.front();
+            reference.erase(reference.begin());
+        } else {
+            mismatches += mixed.pop_max() != reference.back();
+            reference.pop_back();
+        }
+        if (!reference.empty()) {
+            mismatches += mixed.min() != reference.front() || mixed.max() != reference.back();
+        }
+    }
+    std::cout << "Mismatches => Expected: 0, Actual: " << mismatches << "\n";
+    std::cout << "Size       => Expected: " << reference.size() << ", Actual: " << mixed.size() << "\n\n";
+
+    std::cout << "Building from a range of 1000 values and draining from both ends...\n";
+    auto values = std::vector<int>{};
+    for (auto i=0; i<1000; i++) {
+        values.push_back((i * 7919) % 1000);
+    }
+    auto built  = dsc::minmax_heap<int>{values};
+    auto sorted = true;
+    auto low    = -1;
+    auto high   = 1000;
+    while (!built.empty()) {
+        auto lo = built.pop_min();
+        sorted &= lo == low + 1;
+        low     = lo;
+        if (!built.empty()) {
+            auto hi = built.pop_max();
+            sorted &= hi == high - 1;
+            high    = hi;
+        }
+    }
+    std::cout << "Values drained in order => Expected: true, Actual: " << (sorted ? "true" : "false") << "\n\n";
+
+    std::cout << "Strings by length with a custom comparator...\n";
+    auto by_length = [](std::string const& a, std::string const& b) { return a.size() < b.size(); };
+    auto words     = dsc::minmax_heap<std::string, decltype(by_length)>{};
+    for (auto w: {"fig", "banana", "kiwi", "pomegranate", "pear"}) {
+        words.push(w);
+    }
+    std::cout << "min() max() => Expected: fig pomegranate, Actual: " << words.min() << " " << words.max() << "\n";
+
+    auto copy = words;
+    copy.pop_max();
+    std::cout << "Copy is independent => Expected: banana pomegranate, Actual: " << copy.max() << " " << words.max()
+              << "\n\n";
+
+    std::cout << "Allocating from a monotonic buffer resource...\n";
+    auto resource = std::pmr::monotonic_buffer_resource{};
+    auto pooled   = dsc::pmr::minmax_heap<int, std::greater<>>{&resource};
+    for (auto i=0; i<100; i++) {
+        pooled.push(i);
+    }
+    std::cout << "Reversed order min() max() => Expected: 99 0, Actual: " << pooled.min() << " " << pooled.max() << "\n";
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+
+#include <dsc/heap.hpp>
+#include <dsc/ring_vector.hpp>
+#include <dsc/safe_queue.hpp>
+#include <dsc/splay_tree.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const REQUESTS = 20000;
+
+auto allocation_count = 0ll;
+
+// Every global allocation is counted, so any container which falls back to the global heap shows up
+auto operator new(std::size_t size) -> void* {
+    allocation_count++;
+    if (void* mem = std::malloc(size == 0 ? 1 : size)) {
+        return mem;
+    }
+    throw std::bad_alloc{};
+}
+
+auto operator delete(void* mem) noexcept -> void {
+    std::free(mem);
+}
+
+auto operator delete(void* mem, std::size_t) noexcept -> void {
+    std::free(mem);
+}
+
+/** Simulates a request handler which builds temporary containers and throws them away. Each container type is given
+ *  by the caller, along with how to construct it. */
+template<typename Ring, typename Heap, typename Tree, typename Queue, typename Make>
+auto handle_request(int request, Make make) -> long long {
+    auto ring  = make.template operator()<Ring>();
+    auto heap  = make.template operator()<Heap>();
+    auto tree  = make.template operator()<Tree>();
+    auto queue = make.template operator()<Queue>();
+    auto sum   = 0ll;
+
+    for (int i=0; i<512; i++) {
+        ring.push_back(request + i);
+    }
+    for (int i=0; i<256; i++) {
+        heap.push((request * 31 + i * 17) % 1000);
+    }
+    for (int i=0; i<128; i++) {
+        tree.insert((request + i * 37) % 997);
+    }
+    for (int i=0; i<64; i++) {
+        queue.put(ring.pop_front_get());
+    }
+
+    while (!heap.empty()) {
+        sum += heap.pop();
+    }
+    while (auto item = queue.try_get()) {
+        sum += *item;
+    }
+    return sum + static_cast<long long>(tree.size());
+}
+
+auto main() -> int {
+    // Volatile sink keeps the optimizer from discarding the requests
+    volatile long long sink = 0;
+
+    cout << "Handling " << REQUESTS << " requests, each building a ring_vector, heap, splay_tree and safe_queue\n";
+    cout << "   std::allocator...\n";
+    {
+        auto before = allocation_count;
+        auto start  = timer::now();
+        for (auto r=0; r<REQUESTS; r++) {
+            sink = sink + handle_request<dsc::ring_vector<int>, dsc::heap<int, dsc::min_heap>, dsc::splay_tree<int>,
+                                         dsc::safe_queue<int>>(r, []<typename C>() { return C{}; });
+        }
+        auto seconds = std::chrono::duration<double>(timer::now() - start).count();
+        cout << "   Allocations per request: " << static_cast<double>(allocation_count - before) / REQUESTS << "\n";
+        cout << "   Requests per second: " << (REQUESTS / seconds) << "\n";
+    }
+
+    cout << "   dsc::pmr containers on a per request monotonic_buffer_resource...\n";
+    {
+        // One buffer reused by every request. The upstream is the null resource, so overflowing it would throw.
+        static auto buffer = std::array<std::byte, 1 << 20>{};
+        auto before = allocation_count;
+        auto start  = timer::now();
+        for (auto r=0; r<REQUESTS; r++) {
+            auto arena = std::pmr::monotonic_buffer_resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+            sink = sink + handle_request<dsc::pmr::ring_vector<int>, dsc::pmr::heap<int, dsc::min_heap>,
+                                         dsc::pmr::splay_tree<int>, dsc::pmr::safe_queue<int>>(r, [&]<typename C>() {
+                return C{typename C::allocator_type{&arena}};
+            });
+        }
+        auto seconds = std::chrono::duration<double>(timer::now() - start).count();
+        cout << "   Allocations per request: " << static_cast<double>(allocation_count - before) / REQUESTS << "\n";
+        cout << "   Requests per second: " << (REQUESTS / seconds) << "\n";
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <dsc/heap.hpp>
+#include <dsc/radix_heap.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const HOLDS = 1 << 24;
+
+/** Delays of the simulated events */
+enum class trace {
+    /** Integer ticks drawn uniformly from 0 to a million */
+    uniform,
+    /** Integer ticks rounded to multiples of 1000, so many events share a timestamp */
+    bursty,
+    /** Double precision seconds drawn from an exponential distribution with a mean of one */
+    exponential,
+};
+
+/** 64 bit linear congruential generator */
+struct lcg {
+    std::uint64_t state;
+
+    auto next() -> std::uint64_t {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return state >> 11;
+    }
+};
+
+/** Returns the next delay of trace t, as Key */
+template<typename Key>
+auto next_delay(trace t, lcg& random) -> Key {
+    switch (t) {
+        case trace::uniform:
+            return static_cast<Key>(random.next() % 1'000'000);
+        case trace::bursty:
+            return static_cast<Key>(random.next() % 1'000 * 1'000);
+        case trace::exponential:
+        default:
+            return static_cast<Key>(-std::log1p(-static_cast<double>(random.next()) / 9007199254740992.0));
+    }
+}
+
+/** Times a hold model simulation: pending events are scheduled, then HOLDS times the earliest event is popped and
+ *  schedules one more a random delay later, as a discrete event simulator does. push and pop adapt the queue. The
+ *  checksum sums the ids popped. dsc::heap breaks ties between equal times by id and radix_heap does not, so the
+ *  checksums of integer traces, which have ties, differ between the two. */
+template<typename Key, typename Push, typename Pop>
+auto simulate(trace t, std::uint32_t pending, Push push, Pop pop) -> void {
+    auto random = lcg{42};
+    for (std::uint32_t id=0; id < pending; id++) {
+        push(next_delay<Key>(t, random), id);
+    }
+
+    auto start    = timer::now();
+    auto checksum = std::uint64_t{0};
+    for (auto hold=0; hold < HOLDS; hold++) {
+        auto [time, id] = pop();
+        checksum += id;
+        push(time + next_delay<Key>(t, random), id);
+    }
+    auto seconds  = std::chrono::duration<double>(timer::now() - start).count();
+    cout << "      Elapsed time: " << seconds << " (" << HOLDS / seconds / 1e6 << " M holds per second), checksum "
+         << checksum << "\n";
+}
+
+/** Runs trace t with pending events on a binary dsc::heap, a 4-ary dsc::heap and a radix_heap */
+template<typename Key>
+auto compare(trace t, char const* name, std::uint32_t pending) -> void {
+    using event = std::pair<Key, std::uint32_t>;
+    cout << name << " trace with " << pending << " pending events...\n";
+    {
+        cout << "   dsc::heap<.., min_heap>\n";
+        auto queue = dsc::heap<event, dsc::min_heap>{};
+        simulate<Key>(t, pending, [&](Key time, std::uint32_t id) { queue.push(event{time, id}); },
+                      [&] { return queue.pop(); });
+    }
+    {
+        cout << "   dsc::heap<.., min_heap, .., 4>\n";
+        auto queue = dsc::heap<event, dsc::min_heap, std::allocator<event>, 4>{};
+        simulate<Key>(t, pending, [&](Key time, std::uint32_t id) { queue.push(event{time, id}); },
+                      [&] { return queue.pop(); });
+    }
+    {
+        cout << "   dsc::radix_heap\n";
+        auto queue = dsc::radix_heap<Key, std::uint32_t>{};
+        simulate<Key>(t, pending, [&](Key time, std::uint32_t id) { queue.push(time, id); },
+                      [&] { return queue.pop(); });
+    }
+}
+
+auto main() -> int {
+    for (std::uint32_t pending: {1u << 10, 1u << 16, 1u << 20}) {
+        compare<std::uint64_t>(trace::uniform, "Uniform integer", pending);
+        compare<std::uint64_t>(trace::bursty, "Bursty integer", pending);
+        compare<double>(trace::exponential, "Exponential double", pending);
+    }
+}
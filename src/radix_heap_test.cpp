@@ -0,0 +1,128 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dsc/heap.hpp"
+#include "dsc/radix_heap.hpp"
+
+/** Runs a hold model simulation of steps pops, each pushing an event a random delay later, on a radix_heap and on
+ *  a dsc::heap, and returns true if both pop the same keys in the same order */
+auto matches_heap(std::size_t pending, std::size_t steps, std::uint64_t max_delay, std::uint64_t seed) -> bool {
+    using event = std::pair<std::uint64_t, std::uint32_t>;
+    auto radix  = dsc::radix_heap<std::uint64_t, std::uint32_t>{};
+    auto binary = dsc::heap<event, dsc::min_heap>{};
+    auto delay  = [&] {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        return (seed >> 33) % (max_delay + 1);
+    };
+
+    for (std::uint32_t id=0; id < pending; id++) {
+        auto time = delay();
+        radix.push(time, id);
+        binary.push(event{time, id});
+    }
+    for (std::size_t step=0; step < steps; step++) {
+        auto [time, id] = radix.pop();
+        auto expected   = binary.pop();
+        if (time != expected.first || radix.size() != binary.size()) {
+            return false;
+        }
+        auto next = time + delay();
+        radix.push(next, id);
+        binary.push(event{next, id});
+    }
+    while (!radix.empty()) {
+        if (radix.pop().first != binary.pop().first) {
+            return false;
+        }
+    }
+    return binary.empty();
+}
+
+int main() {
+    std::cout << "Pushing 5 3 9 3 7 with names, then popping...\n";
+    auto heap = dsc::radix_heap<std::uint32_t, std::string>{};
+    for (auto [key, name]: {std::pair{5u, "five"}, {3u, "three"}, {9u, "nine"}, {3u, "three"}, {7u, "seven"}}) {
+        heap.push(key, name);
+    }
+    std::cout << "size() => Expected: 5, Actual: " << heap.size() << "\n";
+    std::cout << "top()  => Expected: 3 three, Actual: " << heap.top().first << " " << heap.top().second << "\n";
+    std::cout << "pop()  => Expected: 3 3 5, Actual: ";
+    for (auto i=0; i<3; i++) {
+        std::cout << heap.pop().first << " ";
+    }
+    std::cout << "\n";
+    std::cout << "last_key() => Expected: 5, Actual: " << heap.last_key() << "\n";
+    heap.push(5, "five again");
+    heap.push(6, "six");
+    std::cout << "Push equal to and above the last key, then pop all => Expected: 5 6 7 9, Actual: ";
+    while (!heap.empty()) {
+        std::cout << heap.pop().first << " ";
+    }
+    std::cout << "\n";
+    try {
+        heap.push(4, "four");
+        std::cout << "Push below the last key => Expected: invalid_argument, Actual: no error\n";
+    } catch (std::invalid_argument const&) {
+        std::cout << "Push below the last key => Expected: invalid_argument, Actual: invalid_argument\n";
+    }
+    heap.clear();
+    heap.push(4, "four");
+    std::cout << "clear() forgets the last key => Expected: 4, Actual: " << heap.top().first << "\n\n";
+
+    std::cout << "Float and double keys, including negatives and both zeros...\n";
+    auto floats = dsc::radix_heap<float, int>{};
+    for (float key: {2.5f, -1.0f, 0.0f, -3.25f, 1e30f, -0.0f, 0.5f}) {
+        floats.push(key, 0);
+    }
+    std::cout << "float pops  => Expected: -3.25 -1 0 0 0.5 2.5 1e+30, Actual: ";
+    while (!floats.empty()) {
+        // -0.0 and 0.0 are equal keys, popped in either order, so both print as 0
+        auto key = floats.pop().first;
+        std::cout << (key == 0.0f ? 0.0f : key) << " ";
+    }
+    std::cout << "\n";
+    auto doubles = dsc::radix_heap<double, int>{};
+    doubles.push(-0.5, 0);
+    doubles.push(0.25, 0);
+    doubles.pop();
+    doubles.push(-0.25, 0);
+    doubles.push(0.0, 0);
+    std::cout << "double pops => Expected: -0.25 0 0.25, Actual: ";
+    while (!doubles.empty()) {
+        std::cout << doubles.pop().first << " ";
+    }
+    std::cout << "\n";
+    std::cout << "double last_key() => Expected: 0.25, Actual: " << doubles.last_key() << "\n\n";
+
+    std::cout << "Hold model simulations against dsc::heap...\n";
+    std::cout << "16 pending, delays up to 10      => Expected: true, Actual: "
+              << (matches_heap(16, 100'000, 10, 1) ? "true" : "false") << "\n";
+    std::cout << "1000 pending, delays up to 1e6   => Expected: true, Actual: "
+              << (matches_heap(1000, 100'000, 1'000'000, 2) ? "true" : "false") << "\n";
+    std::cout << "100 pending, delays up to 2^40   => Expected: true, Actual: "
+              << (matches_heap(100, 100'000, std::uint64_t{1} << 40, 3) ? "true" : "false") << "\n\n";
+
+    std::cout << "8 bit keys and a pmr allocator...\n";
+    auto pool  = std::pmr::unsynchronized_pool_resource{};
+    auto small = dsc::pmr::radix_heap<std::uint8_t, int>{&pool};
+    for (int key: {255, 0, 128, 127, 1}) {
+        small.push(static_cast<std::uint8_t>(key), key);
+    }
+    std::cout << "pops => Expected: 0 1 127 128 255, Actual: ";
+    while (!small.empty()) {
+        std::cout << small.pop().second << " ";
+    }
+    std::cout << "\n";
+    std::cout << "Allocator uses pool => Expected: true, Actual: "
+              << (small.get_allocator().resource() == &pool ? "true" : "false") << "\n";
+
+    return 0;
+}
@@ -0,0 +1,444 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <dsc/incremental_ring_vector.hpp>
+#include <dsc/mirrored_allocator.hpp>
+#include <dsc/ring_io.hpp>
+#include <dsc/ring_vector.hpp>
+#include <dsc/segmented.hpp>
+#include <dsc/small_ring_vector.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const NUM_VALUES = 1 << 24;
+auto const ROUNDS     = 20;
+auto rd               = std::random_device{};
+auto gen              = std::mt19937 {rd()};
+
+auto allocation_count = 0ll;
+
+/** std::allocator which counts calls to allocate in allocation_count */
+template<typename T>
+struct counting_allocator: std::allocator<T> {
+    using value_type = T;
+
+    counting_allocator() = default;
+    template<typename U>
+    counting_allocator(counting_allocator<U> const&) {}
+
+    auto allocate(size_t n) -> T* {
+        allocation_count++;
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+/** Prints the time elapsed since start in seconds */
+auto print_elapsed(timer::time_point start) {
+    auto end = timer::now();
+    cout << "   Elapsed time: " << (std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count()/1000.0) << "\n";
+}
+
+/** Builds a vector of NUM_VALUES random values whose elements wrap around the end of the backing array */
+auto make_wrapped_vector() -> dsc::ring_vector<int> {
+    auto next = std::uniform_int_distribution<>(0, 1000);
+    auto vec  = dsc::ring_vector<int>{NUM_VALUES};
+
+    for (auto i=0; i<NUM_VALUES/2; i++) {
+        vec.push_back(next(gen));
+        vec.push_front(next(gen));
+    }
+    return vec;
+}
+
+/** Compares segmented algorithms against the same operation through the masked iterator */
+auto test_segmented_algorithms() -> void {
+    auto vec = make_wrapped_vector();
+    // Volatile sink keeps the optimizer from discarding the loops
+    volatile long long sink = 0;
+
+    cout << "Summing " << NUM_VALUES << " ints, " << ROUNDS << " rounds\n";
+    cout << "   Masked iterator...\n";
+    {
+        auto start = timer::now();
+        for (auto r=0; r<ROUNDS; r++) {
+            auto sum = 0ll;
+            for (auto v: vec) {
+                sum += v;
+            }
+            sink = sink + sum;
+        }
+        print_elapsed(start);
+    }
+    cout << "   Segmented accumulate...\n";
+    {
+        auto start = timer::now();
+        for (auto r=0; r<ROUNDS; r++) {
+            sink = sink + dsc::accumulate(vec, 0ll);
+        }
+        print_elapsed(start);
+    }
+    cout << "\n";
+
+    cout << "Counting value in " << NUM_VALUES << " ints, " << ROUNDS << " rounds\n";
+    cout << "   Masked iterator...\n";
+    {
+        auto start = timer::now();
+        for (auto r=0; r<ROUNDS; r++) {
+            sink = sink + std::count(vec.begin(), vec.end(), r);
+        }
+        print_elapsed(start);
+    }
+    cout << "   Segmented count...\n";
+    {
+        auto start = timer::now();
+        for (auto r=0; r<ROUNDS; r++) {
+            sink = sink + dsc::count(vec, r);
+        }
+        print_elapsed(start);
+    }
+    cout << "\n";
+
+    cout << "Finding missing value in " << NUM_VALUES << " ints, " << ROUNDS << " rounds\n";
+    cout << "   Masked iterator...\n";
+    {
+        auto start = timer::now();
+        for (auto r=0; r<ROUNDS; r++) {
+            auto pos = 0ll;
+            for (auto it=vec.begin(); it != vec.end() && *it != -1; ++it) {
+                pos++;
+            }
+            sink = sink + pos;
+        }
+        print_elapsed(start);
+    }
+    cout << "   Segmented find...\n";
+    {
+        auto start = timer::now();
+        for (auto r=0; r<ROUNDS; r++) {
+            sink = sink + dsc::find(vec, -1);
+        }
+        print_elapsed(start);
+    }
+    cout << "\n";
+
+    cout << "Finding min and max of " << NUM_VALUES << " ints, " << ROUNDS << " rounds\n";
+    cout << "   Masked iterator...\n";
+    {
+        auto start = timer::now();
+        for (auto r=0; r<ROUNDS; r++) {
+            auto lo = vec[0];
+            auto hi = vec[0];
+            for (auto v: vec) {
+                lo = std::min(lo, v);
+                hi = std::max(hi, v);
+            }
+            sink = sink + lo + hi;
+        }
+        print_elapsed(start);
+    }
+    cout << "   Segmented min_element/max_element...\n";
+    {
+        auto start = timer::now();
+        for (auto r=0; r<ROUNDS; r++) {
+            sink = sink + vec[dsc::min_element(vec)] + vec[dsc::max_element(vec)];
+        }
+        print_elapsed(start);
+    }
+    cout << "\n";
+}
+
+/** Compares the wrap aware sort() against std::sort through the masked iterator */
+auto test_sort() -> void {
+    cout << "Sorting " << NUM_VALUES << " wrapped ints\n";
+    cout << "   std::sort through iterator...\n";
+    {
+        auto vec   = make_wrapped_vector();
+        auto start = timer::now();
+        std::sort(vec.begin(), vec.end());
+        print_elapsed(start);
+    }
+    cout << "   ring_vector::sort...\n";
+    {
+        auto vec   = make_wrapped_vector();
+        auto start = timer::now();
+        vec.sort();
+        print_elapsed(start);
+    }
+    cout << "\n";
+}
+
+/** Sums the first field of every complete comma separated line in text. Returns the number of bytes consumed. */
+auto parse_lines(std::string_view text, long long& sum) -> size_t {
+    auto consumed = size_t{0};
+    while (true) {
+        auto newline = text.find('\n', consumed);
+        if (newline == std::string_view::npos) {
+            return consumed;
+        }
+
+        auto field = 0ll;
+        for (auto idx=consumed; idx < newline && text[idx] != ','; idx++) {
+            field = field*10 + (text[idx] - '0');
+        }
+        sum      += field;
+        consumed  = newline + 1;
+    }
+}
+
+/** Streams input through ring repeatedly, parsing whatever complete lines are buffered each time it fills up. view
+ *  turns the buffered bytes into a contiguous string_view. Returns parse throughput in MB/s. */
+template<typename Vector, typename View>
+auto run_parse(Vector& ring, std::string const& input, View view) -> double {
+    auto parse_time = timer::duration{};
+    auto parsed     = size_t{0};
+    auto sum        = 0ll;
+
+    for (auto r=0; r<ROUNDS; r++) {
+        for (auto c: input) {
+            ring.push_back(c);
+            if (ring.size() < ring.capacity() - 256) {
+                continue;
+            }
+
+            auto start    = timer::now();
+            auto consumed = parse_lines(view(ring), sum);
+            parse_time   += timer::now() - start;
+
+            parsed += consumed;
+            for (size_t i=0; i<consumed; i++) {
+                ring.pop_front();
+            }
+        }
+    }
+
+    cout << "   Checksum: " << sum << "\n";
+    return parsed / std::chrono::duration<double>(parse_time).count() / (1 << 20);
+}
+
+/** Compares parsing lines out of a ring buffer which copies at the wrap point against a mirrored ring buffer */
+auto test_parse() -> void {
+    auto next  = std::uniform_int_distribution<>(0, 1000000);
+    auto input = std::string{};
+    while (input.size() < (1 << 22)) {
+        input += std::to_string(next(gen)) + "," + std::to_string(next(gen)) + ",some,text,fields\n";
+    }
+
+    cout << "Parsing " << ROUNDS << " x " << (input.size() >> 20) << " MB of lines through a 64 KB ring\n";
+    cout << "   Copying wrapped bytes into a linear buffer...\n";
+    {
+        auto ring    = dsc::ring_vector<char>{1 << 16};
+        auto scratch = std::string{};
+        auto rate    = run_parse(ring, input, [&](auto& vec) {
+            auto [first, second] = vec.as_spans();
+            if (second.empty()) {
+                return std::string_view{first.data(), first.size()};
+            }
+            scratch.assign(first.data(), first.size());
+            scratch.append(second.data(), second.size());
+            return std::string_view{scratch};
+        });
+        cout << "   Parse throughput: " << rate << " MB/s\n";
+    }
+    cout << "   Mirrored contiguous_view...\n";
+    {
+        auto ring = dsc::ring_vector<char, dsc::mirrored_allocator<char>>{1 << 16};
+        auto rate = run_parse(ring, input, [](auto& vec) {
+            auto view = vec.contiguous_view();
+            return std::string_view{view.data(), view.size()};
+        });
+        cout << "   Parse throughput: " << rate << " MB/s\n";
+    }
+    cout << "\n";
+}
+
+/** Times every push_back into an empty vector and prints latency percentiles */
+template<typename Vector>
+auto run_push_latency() -> void {
+    auto vec       = Vector{};
+    auto latencies = std::vector<long long>{};
+    latencies.reserve(NUM_VALUES);
+
+    for (auto i=0; i<NUM_VALUES; i++) {
+        auto start = timer::now();
+        vec.push_back(i);
+        auto end   = timer::now();
+        latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count());
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    cout << "   p50: "    << percentile(0.5)    << " ns"
+         << ", p99: "    << percentile(0.99)   << " ns"
+         << ", p99.9: "  << percentile(0.999)  << " ns"
+         << ", p99.99: " << percentile(0.9999) << " ns"
+         << ", max: "    << latencies.back()   << " ns\n";
+}
+
+/** Compares push_back tail latency of doubling all at once against incremental migration */
+auto test_push_latency() -> void {
+    cout << "Latency of " << NUM_VALUES << " push_back calls starting from empty\n";
+    cout << "   ring_vector...\n";
+    run_push_latency<dsc::ring_vector<int>>();
+    cout << "   incremental_ring_vector...\n";
+    run_push_latency<dsc::incremental_ring_vector<int>>();
+    cout << "\n";
+}
+
+/** Builds many short lived queues of a few elements each and reports heap allocations per queue operation */
+template<typename Vector>
+auto run_small_queues(int queue_length) -> void {
+    auto const num_queues = 1000000;
+    // Volatile sink keeps the optimizer from discarding the loops
+    volatile long long sink = 0;
+
+    allocation_count = 0;
+    auto start = timer::now();
+    for (auto q=0; q<num_queues; q++) {
+        auto queue = Vector{};
+        for (auto i=0; i<queue_length; i++) {
+            queue.push_back(i);
+        }
+        while (!queue.empty()) {
+            sink = sink + queue.pop_front_get();
+        }
+    }
+    print_elapsed(start);
+
+    auto operations = static_cast<double>(num_queues) * queue_length * 2;
+    cout << "   Allocations per operation: " << (allocation_count / operations) << "\n";
+}
+
+/** Compares short lived queues in ring_vector against small_ring_vector with 16 inline elements */
+auto test_small_queues() -> void {
+    for (auto queue_length: {4, 16, 64}) {
+        cout << "1000000 queues of " << queue_length << " ints, push all then pop all\n";
+        cout << "   ring_vector...\n";
+        run_small_queues<dsc::ring_vector<int, counting_allocator<int>>>(queue_length);
+        cout << "   small_ring_vector<int, 16>...\n";
+        run_small_queues<dsc::small_ring_vector<int, 16, counting_allocator<int>>>(queue_length);
+        cout << "\n";
+    }
+}
+
+/** Compares keeping the last 4096 samples with push_back and pop_front pairs against push_back_overwrite */
+auto test_flight_recorder() -> void {
+    auto const num_pushes = 100000000;
+    // Volatile sink keeps the optimizer from discarding the loops
+    volatile long long sink = 0;
+
+    cout << "Recording " << num_pushes << " samples into a window of 4096\n";
+    cout << "   push_back and pop_front...\n";
+    {
+        auto window = dsc::ring_vector<long long>{4096};
+        auto start  = timer::now();
+        for (auto i=0; i<num_pushes; i++) {
+            if (window.size() == 4096) {
+                window.pop_front();
+            }
+            window.push_back(i);
+        }
+        auto seconds = std::chrono::duration<double>(timer::now() - start).count();
+        sink = sink + window.back();
+        cout << "   Pushes per second: " << (num_pushes / seconds / 1e6) << " M\n";
+    }
+    cout << "   push_back_overwrite...\n";
+    {
+        auto window = dsc::ring_vector<long long>{4096};
+        auto start  = timer::now();
+        for (auto i=0; i<num_pushes; i++) {
+            window.push_back_overwrite(i);
+        }
+        auto seconds = std::chrono::duration<double>(timer::now() - start).count();
+        sink = sink + window.back();
+        cout << "   Pushes per second: " << (num_pushes / seconds / 1e6) << " M\n";
+    }
+    cout << "\n";
+}
+
+
+/** Fills every free slot of buffer, which wraps because its front is never at slot 0 */
+auto refill(dsc::ring_vector<std::byte>& buffer) -> void {
+    auto [first, second] = buffer.free_spans();
+    std::memset(first.data(), 'x', first.size());
+    std::memset(second.data(), 'y', second.size());
+    buffer.commit_back(first.size() + second.size());
+}
+
+/** Flushes a full, wrapped 1 MB buffer to fd write_rounds times, either by copying it into a linear buffer and
+ *  calling write or through write_to */
+auto run_write(int fd, bool copy_first, int write_rounds) -> void {
+    auto buffer = dsc::ring_vector<std::byte>{1 << 20};
+    auto linear = std::vector<std::byte>(buffer.capacity());
+    buffer.push_back(std::byte{0});
+    buffer.pop_front(1);
+
+    auto start = timer::now();
+    for (auto r=0; r<write_rounds; r++) {
+        lseek(fd, 0, SEEK_SET);
+        refill(buffer);
+        if (copy_first) {
+            auto [first, second] = buffer.as_spans();
+            std::memcpy(linear.data(), first.data(), first.size());
+            std::memcpy(linear.data() + first.size(), second.data(), second.size());
+            auto total   = buffer.size();
+            auto written = std::size_t{0};
+            while (written < total) {
+                written += static_cast<std::size_t>(::write(fd, linear.data() + written, total - written));
+            }
+            buffer.pop_front(total);
+        } else {
+            while (!buffer.empty()) {
+                dsc::write_to(buffer, fd);
+            }
+        }
+    }
+    auto seconds = std::chrono::duration<double>(timer::now() - start).count();
+    cout << "   Throughput: " << (write_rounds / seconds) << " MB/s\n";
+}
+
+/** Compares flushing a wrapped byte buffer with writev against copying it to a linear buffer first */
+auto test_write() -> void {
+    auto const write_rounds = 4000;
+    auto* file   = std::tmpfile();
+    auto  null   = open("/dev/null", O_WRONLY);
+
+    cout << "Flushing a wrapped 1 MB ring_vector<std::byte> " << write_rounds << " times\n";
+    cout << "   Copy then write to temp file...\n";
+    run_write(fileno(file), true, write_rounds);
+    cout << "   write_to temp file...\n";
+    run_write(fileno(file), false, write_rounds);
+    cout << "   Copy then write to /dev/null...\n";
+    run_write(null, true, write_rounds);
+    cout << "   write_to /dev/null...\n";
+    run_write(null, false, write_rounds);
+    cout << "\n";
+
+    close(null);
+    std::fclose(file);
+}
+
+
+auto main() -> int {
+    test_segmented_algorithms();
+    test_sort();
+    test_parse();
+    test_push_latency();
+    test_small_queues();
+    test_flight_recorder();
+    test_write();
+}
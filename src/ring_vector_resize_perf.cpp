@@ -0,0 +1,77 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <dsc/mmap_allocator.hpp>
+#include <dsc/ring_vector.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+/** Fills a ring vector of the given size in bytes so that it is full and wrapped, then times the push_back which
+ *  doubles its capacity */
+template<typename Allocator>
+auto time_growth(size_t bytes) -> void {
+    auto const count = bytes / sizeof(uint64_t);
+    auto vec         = dsc::ring_vector<uint64_t, Allocator>{count};
+
+    // A rolling window which has wrapped a quarter of the way around the array
+    for (size_t i=0; i<count/4; i++) {
+        vec.push_front(i);
+    }
+    for (size_t i=count/4; i<count; i++) {
+        vec.push_back(i);
+    }
+
+    auto start = timer::now();
+    vec.push_back(count);
+    auto end   = timer::now();
+
+    cout << "   Resize latency: " << (std::chrono::duration_cast<std::chrono::microseconds>(end-start).count()/1000.0) << " ms\n";
+    cout << "   Capacity after: " << vec.capacity() << "\n";
+}
+
+/** Runs time_growth in a child process so that each case reports its own peak resident set size */
+template<typename Allocator>
+auto run_case(char const* name, size_t bytes) -> void {
+    cout << name << ", " << (bytes >> 20) << " MB of uint64_t\n";
+    cout.flush();
+
+    auto pid = fork();
+    if (pid == 0) {
+        time_growth<Allocator>(bytes);
+        cout.flush();
+        std::_Exit(0);
+    }
+
+    auto status = 0;
+    auto usage  = rusage{};
+    wait4(pid, &status, 0, &usage);
+    cout << "   Peak RSS:       " << (usage.ru_maxrss / 1024) << " MB\n";
+    cout << "\n";
+}
+
+
+/** Sizes are given in MB on the command line, defaulting to 1 GB and 8 GB */
+auto main(int argc, char *argv[]) -> int {
+    auto sizes = std::vector<size_t>{};
+    for (auto i=1; i<argc; i++) {
+        sizes.push_back(static_cast<size_t>(std::atoll(argv[i])) << 20);
+    }
+    if (sizes.empty()) {
+        sizes = {size_t{1} << 30, size_t{8} << 30};
+    }
+
+    for (auto bytes: sizes) {
+        run_case<std::allocator<uint64_t>>("std::allocator", bytes);
+        run_case<dsc::mmap_allocator<uint64_t>>("dsc::mmap_allocator", bytes);
+    }
+}
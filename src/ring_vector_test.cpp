@@ -1,9 +1,52 @@
 // Copyright 2020 Nathaniel Mitchell
 
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <ranges>
+#include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
+#include "dsc/hugepage_allocator.hpp"
+#include "dsc/mirrored_allocator.hpp"
+#include "dsc/mmap_allocator.hpp"
+#include "dsc/ring_io.hpp"
 #include "dsc/ring_vector.hpp"
+#include "dsc/segmented.hpp"
+
+static_assert(std::random_access_iterator<dsc::ring_vector<int>::iterator>);
+static_assert(std::random_access_iterator<dsc::ring_vector<int>::const_iterator>);
+static_assert(std::ranges::random_access_range<dsc::ring_vector<int>>);
+static_assert(std::ranges::random_access_range<dsc::ring_vector<int> const>);
+
+/** Memory resource which throws std::bad_alloc once a budget of allocations is used up */
+class limited_resource: public std::pmr::memory_resource {
+    auto do_allocate(std::size_t bytes, std::size_t align) -> void* override {
+        if (budget-- <= 0) {
+            throw std::bad_alloc{};
+        }
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    auto do_deallocate(void* p, std::size_t bytes, std::size_t align) -> void override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override { return this == &other; }
+
+ public:
+    int budget = 0;
+};
 
 class Test {
     int * allocated;
@@ -203,10 +246,320 @@ int main() {
     std::cout << "it = vec.begin()  => Expected: 1,    Actual: " << it->val() << "\n";
     it += 2;
     std::cout << "it += 2           => Expected: 3,    Actual: " << it->val() << "\n";
-    it -= 3;
-    std::cout << "it -= 3           => Expected: 1,    Actual: " << it->val() << "\n";
+    it -= 2;
+    std::cout << "it -= 2           => Expected: 1,    Actual: " << it->val() << "\n";
     std::cout << "it == vec.begin() => Expected: true, Actual: " << (it==vec.begin() ? "true" : "false") << "\n";
-    it += 15;
-    std::cout << "it += 15\n";
+    it += 10;
+    std::cout << "it += 10\n";
     std::cout << "it == vec.end()   => Expected: true, Actual: " << (it==vec.end() ? "true" : "false") << "\n";
+    std::cout << "vec.end() - vec.begin() => Expected: 10, Actual: " << (vec.end() - vec.begin()) << "\n";
+    std::cout << "vec.begin()[4]          => Expected: 5,  Actual: " << vec.begin()[4].val() << "\n";
+
+    std::cout << "\n";
+    std::cout << "Constructing wrapped int vector of 1..10 to test as_spans() and segmented algorithms...\n";
+    auto ints = dsc::ring_vector<int>{8};
+    for (int i=6; i<=10; i++) {
+        ints.push_back(i);
+    }
+    for (int i=5; i>0; i--) {
+        ints.push_front(i);
+    }
+
+    auto [first, second] = ints.as_spans();
+    std::cout << "First segment:  ";
+    for (auto v: first) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "Second segment: ";
+    for (auto v: second) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+
+    std::cout << "find(ints, 7)       => Expected: 6,  Actual: " << dsc::find(ints, 7) << "\n";
+    std::cout << "find(ints, 42)      => Expected: 10, Actual: " << dsc::find(ints, 42) << "\n";
+    std::cout << "count(ints, 3)      => Expected: 1,  Actual: " << dsc::count(ints, 3) << "\n";
+    std::cout << "accumulate(ints, 0) => Expected: 55, Actual: " << dsc::accumulate(ints, 0) << "\n";
+    std::cout << "min_element(ints)   => Expected: 0,  Actual: " << dsc::min_element(ints) << "\n";
+    std::cout << "max_element(ints)   => Expected: 9,  Actual: " << dsc::max_element(ints) << "\n";
+
+    auto nans = dsc::ring_vector<double>{};
+    for (double v: {2.0, 1.0, 3.0}) {
+        nans.push_back(v);
+    }
+    nans.push_front(std::numeric_limits<double>::quiet_NaN());
+    std::cout << "min_element(nans)   => Expected: 0,  Actual: " << dsc::min_element(nans) << "\n";
+    std::cout << "max_element(nans)   => Expected: 0,  Actual: " << dsc::max_element(nans) << "\n";
+    nans.pop_front();
+    nans.push_back(std::numeric_limits<double>::quiet_NaN());
+    std::cout << "min_element(nans)   => Expected: 1,  Actual: " << dsc::min_element(nans) << "\n";
+    std::cout << "max_element(nans)   => Expected: 2,  Actual: " << dsc::max_element(nans) << "\n";
+
+    std::cout << "\n";
+    std::cout << "Sorting wrapped vector of 20 shuffled ints with sort()...\n";
+    auto shuffled = std::vector<int>{};
+    for (int i=1; i<=20; i++) {
+        shuffled.push_back(i);
+    }
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{std::random_device{}()});
+
+    auto sortvec = dsc::ring_vector<int>{32};
+    for (int i=0; i<10; i++) {
+        sortvec.push_back(shuffled[i]);
+        sortvec.push_front(shuffled[i+10]);
+    }
+    sortvec.sort();
+
+    std::cout << "Values: ";
+    for (auto v: sortvec) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "is_sorted           => Expected: true, Actual: " << (std::is_sorted(sortvec.begin(), sortvec.end()) ? "true" : "false") << "\n";
+    std::cout << "lower_bound(13)     => Expected: 12,   Actual: " << (std::ranges::lower_bound(sortvec, 13) - sortvec.begin()) << "\n";
+
+    sortvec.sort(std::execution::seq, std::greater<>{});
+    std::cout << "Sorted descending:  ";
+    for (auto v: sortvec) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+
+    std::cout << "\n";
+    std::cout << "Growing wrapped vectors backed by mmap_allocator through mremap...\n";
+    for (int front_count: {3, 13}) {
+        auto mapped = dsc::ring_vector<int, dsc::mmap_allocator<int>>{16};
+        for (int i=front_count+1; i<=16; i++) {
+            mapped.push_back(i);
+        }
+        for (int i=front_count; i>0; i--) {
+            mapped.push_front(i);
+        }
+        for (int i=17; i<=20; i++) {
+            mapped.push_back(i);
+        }
+
+        std::cout << "Values:   ";
+        for (auto v: mapped) {
+            std::cout << v << " ";
+        }
+        std::cout << "\n";
+        std::cout << "Capacity: " << mapped.capacity() << "\n";
+    }
+
+    std::cout << "\n";
+    std::cout << "Wrapping a char vector backed by mirrored_allocator and reading it through contiguous_view()...\n";
+    auto mirrored = dsc::ring_vector<char, dsc::mirrored_allocator<char>>{};
+    std::cout << "Capacity: " << mirrored.capacity() << "\n";
+    for (size_t i=0; i<mirrored.capacity()-3; i++) {
+        mirrored.push_back('.');
+    }
+    while (!mirrored.empty()) {
+        mirrored.pop_front();
+    }
+    for (char c: std::string_view{"hello mirror"}) {
+        mirrored.push_back(c);
+    }
+    auto [head, tail] = mirrored.as_spans();
+    std::cout << "Segments:        " << head.size() << " + " << tail.size() << "\n";
+    auto view = mirrored.contiguous_view();
+    std::cout << "Contiguous view => Expected: hello mirror, Actual: " << std::string_view{view.data(), view.size()} << "\n";
+
+    std::cout << "\n";
+    std::cout << "Pushing 1..10 with push_back_overwrite onto a vector bounded at 4...\n";
+    auto recorder = dsc::ring_vector<int>{4};
+    auto evicted  = std::vector<int>{};
+    for (int i=1; i<=10; i++) {
+        recorder.push_back_overwrite(i, [&](int& oldest) { evicted.push_back(oldest); });
+    }
+    std::cout << "Values  => Expected: 7 8 9 10,    Actual: ";
+    for (auto v: recorder) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "Evicted => Expected: 1 2 3 4 5 6, Actual: ";
+    for (auto v: evicted) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "front(), back() => Expected: 7 10, Actual: " << recorder.front() << " " << recorder.back() << "\n";
+    std::cout << "Capacity => Expected: 4, Actual: " << recorder.capacity() << "\n";
+
+    auto rounded = dsc::ring_vector<int>{1000};
+    for (int i=1; i<=2000; i++) {
+        rounded.push_back_overwrite(i);
+    }
+    std::cout << "Bound of ring_vector{1000} => Expected: 1024 977, Actual: " << rounded.size() << " "
+              << rounded.front() << "\n";
+
+    auto moved_recorder = std::move(recorder);
+    for (int i=1; i<=6; i++) {
+        recorder.emplace_back_overwrite(i);
+    }
+    std::cout << "Overwriting a moved-from vector => Expected: 3 4 5 6, Actual: ";
+    for (auto v: recorder) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+
+    auto throwing = dsc::ring_vector<std::string>{4};
+    for (int i=1; i<=4; i++) {
+        throwing.emplace_back_overwrite(std::to_string(i));
+    }
+    try {
+        // Throws std::length_error while constructing the new element
+        throwing.emplace_back_overwrite(std::string::npos, 'x');
+    } catch (std::length_error const&) {
+    }
+    std::cout << "Throwing emplace_back_overwrite => Expected: 1 2 3 4, Actual: ";
+    for (auto& v: throwing) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+
+    std::cout << "\n";
+    std::cout << "Writing a wrapped char vector into a pipe with write_to() and reading it back with read_from()...\n";
+    int pipe_fds[2];
+    if (pipe(pipe_fds) != 0) {
+        std::perror("pipe");
+        return 1;
+    }
+    auto outgoing = dsc::ring_vector<char>{16};
+    for (int i=0; i<10; i++) {
+        outgoing.push_back('.');
+        outgoing.pop_front();
+    }
+    for (char c: std::string_view{"hello pipes!"}) {
+        outgoing.push_back(c);
+    }
+    auto [out_head, out_tail] = outgoing.as_spans();
+    std::cout << "Segments:            " << out_head.size() << " + " << out_tail.size() << "\n";
+    std::cout << "write_to  => Expected: 12, Actual: " << dsc::write_to(outgoing, pipe_fds[1]) << "\n";
+    std::cout << "Remaining => Expected: 0,  Actual: " << outgoing.size() << "\n";
+
+    auto incoming = dsc::ring_vector<char>{8};
+    for (int i=0; i<6; i++) {
+        incoming.push_back('.');
+        incoming.pop_front();
+    }
+    std::cout << "read_from into 8 free slots => Expected: 8, Actual: " << dsc::read_from(incoming, pipe_fds[0]) << "\n";
+    std::cout << "read_from after growing     => Expected: 4, Actual: " << dsc::read_from(incoming, pipe_fds[0]) << "\n";
+    std::cout << "Values => Expected: hello pipes!, Actual: ";
+    for (auto c: incoming) {
+        std::cout << c;
+    }
+    std::cout << "\n";
+
+    outgoing.push_back('!');
+    dsc::write_to(outgoing, pipe_fds[1]);
+    auto moved_incoming = std::move(incoming);
+    std::cout << "read_from moved-from vector => Expected: 1, Actual: " << dsc::read_from(incoming, pipe_fds[0]) << "\n";
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+
+    std::cout << "\n";
+    std::cout << "Streaming 100000 bytes through a 4096 byte vector into a temp file and back...\n";
+    auto* file   = std::tmpfile();
+    auto  fd     = fileno(file);
+    auto  buffer = dsc::ring_vector<std::byte>{4096};
+    auto  next   = 0;
+    while (next < 100000) {
+        // Top up to a partly full buffer so the bytes keep wrapping around the end of the array
+        while (buffer.size() < 3000 && next < 100000) {
+            buffer.push_back(static_cast<std::byte>(next++ % 251));
+        }
+        dsc::write_to(buffer, fd);
+    }
+    lseek(fd, 0, SEEK_SET);
+
+    auto readback   = dsc::ring_vector<std::byte>{};
+    auto mismatches = 0;
+    auto total      = 0;
+    while (dsc::read_from(readback, fd) > 0) {
+        while (!readback.empty()) {
+            mismatches += readback.pop_front_get() != static_cast<std::byte>(total++ % 251);
+        }
+    }
+    std::fclose(file);
+    std::cout << "Bytes read => Expected: 100000, Actual: " << total << "\n";
+    std::cout << "Mismatches => Expected: 0, Actual: " << mismatches << "\n";
+
+    std::cout << "\n";
+    std::cout << "Allocating small and large vectors with hugepage_allocator...\n";
+    auto aligned = dsc::ring_vector<char, dsc::hugepage_allocator<char>>{};
+    aligned.push_back('a');
+    std::cout << "Small array 64 byte aligned => Expected: true, Actual: "
+              << (reinterpret_cast<std::uintptr_t>(&aligned.front()) % 64 == 0 ? "true" : "false") << "\n";
+
+    auto huge = dsc::ring_vector<std::uint64_t, dsc::hugepage_allocator<std::uint64_t>>{1 << 18};
+    huge.push_back(0);
+    std::cout << "Large array 2 MB aligned    => Expected: true, Actual: "
+              << (reinterpret_cast<std::uintptr_t>(&huge.front()) % (1 << 21) == 0 ? "true" : "false") << "\n";
+    huge.pop_back();
+    for (std::uint64_t i=1; i<=(1 << 19); i++) {
+        huge.push_front(i);
+        huge.push_back(i);
+    }
+    std::cout << "Capacity after growth => Expected: 1048576, Actual: " << huge.capacity() << "\n";
+    std::cout << "accumulate => Expected: 274878431232, Actual: " << dsc::accumulate(huge, std::uint64_t{0}) << "\n";
+
+    std::cout << "\n";
+    std::cout << "Propagating polymorphic allocators through copy, move and assignment...\n";
+    auto arena_a = std::pmr::monotonic_buffer_resource{};
+    auto arena_b = std::pmr::monotonic_buffer_resource{};
+    auto in_a    = dsc::pmr::ring_vector<int>{&arena_a};
+    for (int i=1; i<=3; i++) {
+        in_a.push_back(i+3);
+        in_a.push_front(4-i);
+    }
+    auto copy_of_a  = in_a;
+    auto moved_of_a = std::move(in_a);
+    auto in_b       = dsc::pmr::ring_vector<int>{&arena_b};
+    in_b = std::move(moved_of_a);
+    auto resource_name = [&](auto const& vec) {
+        auto* resource = vec.get_allocator().resource();
+        return resource == &arena_a ? "a" : resource == &arena_b ? "b" : "default";
+    };
+    std::cout << "Copy resource             => Expected: default, Actual: " << resource_name(copy_of_a) << "\n";
+    std::cout << "Move assigned resource    => Expected: b,       Actual: " << resource_name(in_b) << "\n";
+    std::cout << "Moved from size           => Expected: 0,       Actual: " << moved_of_a.size() << "\n";
+    std::cout << "Values => Expected: 1 2 3 4 5 6, Actual: ";
+    for (auto v: in_b) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+
+    std::cout << "\n";
+    std::cout << "Assigning across memory resources when the new array cannot be allocated...\n";
+    auto limited  = limited_resource{};
+    limited.budget = 1;
+    auto target   = dsc::pmr::ring_vector<std::string>{&limited};
+    target.push_back("kept");
+    auto source   = dsc::pmr::ring_vector<std::string>{&arena_a};
+    for (int i=1; i<=3; i++) {
+        source.push_back(std::to_string(i));
+    }
+    auto failures = 0;
+    try {
+        target = std::move(source);
+    } catch (std::bad_alloc const&) {
+        failures++;
+    }
+    try {
+        target = source;
+    } catch (std::bad_alloc const&) {
+        failures++;
+    }
+    std::cout << "Failed assignments => Expected: 2,    Actual: " << failures << "\n";
+    std::cout << "Target => Expected: kept,  Actual: ";
+    for (auto& v: target) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "Source => Expected: 1 2 3, Actual: ";
+    for (auto& v: source) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
 }
@@ -0,0 +1,96 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <memory_resource>
+
+#include "dsc/small_ring_vector.hpp"
+
+int main() {
+    std::cout << "Pushing 1..8 with push front/back onto small ring vector with 8 inline elements...\n";
+    auto vec = dsc::small_ring_vector<std::string, 8>{};
+    for (int i=1; i<=4; i++) {
+        vec.push_back(std::to_string(i+4));
+        vec.push_front(std::to_string(5-i));
+    }
+
+    std::cout << "Values: ";
+    for (auto& v: vec) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "Capacity: " << vec.capacity() << "\n";
+    std::cout << "Spilled => Expected: false, Actual: " << (vec.spilled() ? "true" : "false") << "\n\n";
+
+    std::cout << "Moving inline vector...\n";
+    auto moved = std::move(vec);
+    std::cout << "Values: ";
+    for (auto& v: moved) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "Original size => Expected: 0, Actual: " << vec.size() << "\n\n";
+
+    std::cout << "Pushing 9 and 10 to spill onto the heap...\n";
+    moved.push_back("9");
+    moved.push_back("10");
+    std::cout << "Values: ";
+    for (auto& v: moved) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "Capacity: " << moved.capacity() << "\n";
+    std::cout << "Spilled => Expected: true, Actual: " << (moved.spilled() ? "true" : "false") << "\n\n";
+
+    std::cout << "Copying and move-assigning spilled vector...\n";
+    auto copied = moved;
+    vec         = std::move(moved);
+    std::cout << "Copy values:  ";
+    for (auto& v: copied) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "Moved values: ";
+    for (auto& v: vec) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+
+    std::cout << "\n";
+    while (!vec.empty()) {
+        std::cout << "Popping front: " << vec.pop_front_get() << "\n";
+        if (!vec.empty()) {
+            std::cout << "Popping back:  " << vec.pop_back_get() << "\n";
+        }
+    }
+
+    std::cout << "\nMoving and swapping pmr containers across memory resources...\n";
+    auto arena_a = std::pmr::monotonic_buffer_resource{};
+    auto arena_b = std::pmr::monotonic_buffer_resource{};
+    auto in_a    = dsc::pmr::small_ring_vector<std::string, 4>{&arena_a};
+    for (int i=1; i<=6; i++) {
+        in_a.push_back(std::to_string(i));
+    }
+    auto copy_of_a  = in_a;
+    auto moved_of_a = std::move(in_a);
+    auto in_b       = dsc::pmr::small_ring_vector<std::string, 4>{&arena_b};
+    in_b = std::move(moved_of_a);
+    auto resource_name = [&](auto const& container) {
+        auto* resource = container.get_allocator().resource();
+        return resource == &arena_a ? "a" : resource == &arena_b ? "b" : "default";
+    };
+    std::cout << "Copy resource          => Expected: default, Actual: " << resource_name(copy_of_a) << "\n";
+    std::cout << "Move resource          => Expected: a,       Actual: " << resource_name(moved_of_a) << "\n";
+    std::cout << "Move assigned resource => Expected: b,       Actual: " << resource_name(in_b) << "\n";
+    std::cout << "Moved from size        => Expected: 0,       Actual: " << moved_of_a.size() << "\n";
+    auto other_b = dsc::pmr::small_ring_vector<std::string, 4>{&arena_b};
+    other_b.push_back("x");
+    other_b.swap(in_b);
+    std::cout << "Swapped sizes          => Expected: 1 6,     Actual: " << in_b.size() << " " << other_b.size() << "\n";
+    std::cout << "Values => Expected: 1 2 3 4 5 6, Actual: ";
+    for (auto& v: other_b) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+}
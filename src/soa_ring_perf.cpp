@@ -0,0 +1,120 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <cstdint>
+
+#include <dsc/ring_vector.hpp>
+#include <dsc/segmented.hpp>
+#include <dsc/soa_ring.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const NUM_VALUES = 1 << 22;
+auto const ROUNDS     = 20;
+auto rd               = std::random_device{};
+auto gen              = std::mt19937 {rd()};
+
+/** A streamed record with 8 fields, of which the scans below only read price */
+struct record {
+    std::int64_t    id;
+    std::int64_t    timestamp;
+    double          price;
+    double          bid;
+    double          ask;
+    std::int32_t    quantity;
+    std::int32_t    venue;
+    std::int64_t    flags;
+};
+
+using record_ring = dsc::soa_ring<std::int64_t, std::int64_t, double, double, double, std::int32_t, std::int32_t, std::int64_t>;
+
+/** Prints the time elapsed since start in seconds */
+auto print_elapsed(timer::time_point start) {
+    auto end = timer::now();
+    cout << "   Elapsed time: " << (std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count()/1000.0) << "\n";
+}
+
+auto main() -> int {
+    auto next = std::uniform_real_distribution<>(0, 100);
+    auto aos  = dsc::ring_vector<record>{};
+    auto soa  = record_ring{};
+    // Volatile sink keeps the optimizer from discarding the loops
+    volatile double sink = 0;
+
+    cout << "Pushing " << NUM_VALUES << " records with 8 fields, rotating half so the elements wrap\n";
+    cout << "   ring_vector<record>...\n";
+    {
+        auto start = timer::now();
+        for (auto i=0; i<NUM_VALUES; i++) {
+            aos.push_back({i, i, next(gen), 0, 0, 1, 2, 0});
+        }
+        for (auto i=0; i<NUM_VALUES/2; i++) {
+            aos.push_back(aos.pop_front_get());
+        }
+        print_elapsed(start);
+    }
+    cout << "   soa_ring...\n";
+    {
+        auto start = timer::now();
+        for (auto i=0; i<NUM_VALUES; i++) {
+            soa.push_back({i, i, next(gen), 0, 0, 1, 2, 0});
+        }
+        for (auto i=0; i<NUM_VALUES/2; i++) {
+            soa.push_back(soa.pop_front_get());
+        }
+        print_elapsed(start);
+    }
+    cout << "\n";
+
+    cout << "Summing the price field, " << ROUNDS << " rounds\n";
+    cout << "   ring_vector<record> segments...\n";
+    {
+        auto start = timer::now();
+        for (auto r=0; r<ROUNDS; r++) {
+            auto sum = 0.0;
+            aos.for_each_segment([&](auto segment) {
+                for (auto const& rec: segment) {
+                    sum += rec.price;
+                }
+            });
+            sink = sink + sum;
+        }
+        print_elapsed(start);
+    }
+    cout << "   soa_ring price column...\n";
+    {
+        auto start = timer::now();
+        for (auto r=0; r<ROUNDS; r++) {
+            sink = sink + dsc::accumulate(soa.column<2>(), 0.0);
+        }
+        print_elapsed(start);
+    }
+    cout << "\n";
+
+    cout << "Counting records at quantity 1 plus records at venue 2, " << ROUNDS << " rounds\n";
+    cout << "   ring_vector<record> segments...\n";
+    {
+        auto start = timer::now();
+        for (auto r=0; r<ROUNDS; r++) {
+            auto n = std::size_t{0};
+            aos.for_each_segment([&](auto segment) {
+                for (auto const& rec: segment) {
+                    n += (rec.quantity == 1) + (rec.venue == 2);
+                }
+            });
+            sink = sink + static_cast<double>(n);
+        }
+        print_elapsed(start);
+    }
+    cout << "   soa_ring quantity and venue columns...\n";
+    {
+        auto start = timer::now();
+        for (auto r=0; r<ROUNDS; r++) {
+            sink = sink + static_cast<double>(dsc::count(soa.column<5>(), 1) + dsc::count(soa.column<6>(), 2));
+        }
+        print_elapsed(start);
+    }
+}
@@ -0,0 +1,127 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "dsc/segmented.hpp"
+#include "dsc/soa_ring.hpp"
+
+using trade_ring = dsc::soa_ring<int, double, std::string>;
+
+/** Memory resource which throws std::bad_alloc once a budget of allocations is used up */
+class limited_resource: public std::pmr::memory_resource {
+    auto do_allocate(std::size_t bytes, std::size_t align) -> void* override {
+        if (budget-- <= 0) {
+            throw std::bad_alloc{};
+        }
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    auto do_deallocate(void* p, std::size_t bytes, std::size_t align) -> void override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override { return this == &other; }
+
+ public:
+    int budget = 0;
+};
+
+/** Prints every record in the ring as id:price:symbol */
+auto print_records(trade_ring const& ring) -> void {
+    std::cout << "Values: ";
+    for (std::size_t idx=0; idx < ring.size(); idx++) {
+        auto [id, price, symbol] = ring[idx];
+        std::cout << id << ":" << price << ":" << symbol << " ";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "Pushing 6 records with push front/back onto soa ring of int, double, string...\n";
+    auto ring = trade_ring{};
+    for (int i=1; i<=3; i++) {
+        ring.push_back({i+3, (i+3) * 1.5, "s" + std::to_string(i+3)});
+        ring.emplace_front(4-i, (4-i) * 1.5, "s" + std::to_string(4-i));
+    }
+    print_records(ring);
+    std::cout << "Capacity: " << ring.capacity() << "\n\n";
+
+    std::cout << "Popping front and pushing back until the columns wrap...\n";
+    for (int i=7; i<=10; i++) {
+        ring.pop_front();
+        ring.push_back({i, i * 1.5, "s" + std::to_string(i)});
+    }
+    print_records(ring);
+
+    auto [ids_first, ids_second] = ring.column<0>();
+    std::cout << "Id column segment sizes => Expected: 5 1, Actual: " << ids_first.size() << " " << ids_second.size() << "\n";
+    std::cout << "Ids => Expected: 5 6 7 8 9 10, Actual: ";
+    for (auto segment: {ids_first, ids_second}) {
+        for (auto id: segment) {
+            std::cout << id << " ";
+        }
+    }
+    std::cout << "\n";
+    std::cout << "accumulate price column => Expected: 67.5, Actual: " << dsc::accumulate(ring.column<1>(), 0.0) << "\n";
+    std::cout << "max_element price column => Expected: 5, Actual: " << dsc::max_element(ring.column<1>()) << "\n";
+    std::cout << "Symbol at 2 => Expected: s7, Actual: " << ring.get<2>(2) << "\n\n";
+
+    std::cout << "Doubling every price through the column spans...\n";
+    ring.column<1>().for_each_segment([](auto segment) {
+        for (auto& price: segment) {
+            price *= 2;
+        }
+    });
+    std::cout << "Last price => Expected: 30, Actual: " << std::get<1>(ring.back()) << "\n\n";
+
+    std::cout << "Copying and moving the ring...\n";
+    auto copied = ring;
+    auto moved  = std::move(ring);
+    print_records(copied);
+    std::cout << "Moved size => Expected: 6, Actual: " << moved.size() << "\n";
+    std::cout << "Original size => Expected: 0, Actual: " << ring.size() << "\n";
+    ring.push_back({10, 15.0, "s10"});
+    print_records(ring);
+    std::cout << "\n";
+
+    while (!moved.empty()) {
+        auto [id, price, symbol] = moved.pop_front_get();
+        std::cout << "Popping front: " << id << ":" << price << ":" << symbol << "\n";
+        if (!moved.empty()) {
+            auto [back_id, back_price, back_symbol] = moved.pop_back_get();
+            std::cout << "Popping back:  " << back_id << ":" << back_price << ":" << back_symbol << "\n";
+        }
+    }
+
+    std::cout << "\nGrowing a pmr soa ring whose third column allocation fails...\n";
+    auto resource = limited_resource{};
+    resource.budget = 3;
+    auto limited = dsc::pmr::soa_ring<int, double, std::string>{&resource};
+    for (int i=1; i<=4; i++) {
+        limited.push_back({i, i * 1.5, "s" + std::to_string(i)});
+    }
+    resource.budget = 2;
+    try {
+        limited.push_back({5, 7.5, "s5"});
+        std::cout << "Push => Expected: bad_alloc, Actual: no error\n";
+    } catch (std::bad_alloc const&) {
+        std::cout << "Push => Expected: bad_alloc, Actual: bad_alloc\n";
+    }
+    std::cout << "Size, capacity => Expected: 4 4, Actual: " << limited.size() << " " << limited.capacity() << "\n";
+    std::cout << "Resource => Expected: true, Actual: "
+              << (limited.get_allocator().resource() == &resource ? "true" : "false") << "\n";
+    std::cout << "Values => Expected: 1:1.5:s1 2:3:s2 3:4.5:s3 4:6:s4, Actual: ";
+    for (std::size_t idx=0; idx < limited.size(); idx++) {
+        auto [id, price, symbol] = limited[idx];
+        std::cout << id << ":" << price << ":" << symbol << " ";
+    }
+    std::cout << "\n";
+    auto copied_limited = limited;
+    std::cout << "Copy resource is default => Expected: true, Actual: "
+              << (copied_limited.get_allocator().resource() == std::pmr::get_default_resource() ? "true" : "false")
+              << "\n";
+}
@@ -5,6 +5,7 @@
 #include <vector>
 #include <algorithm>
 #include <chrono>
+#include <memory_resource>
 
 #include "dsc/splay_tree.hpp"
 #include "dsc/tree_printer.hpp"
@@ -95,6 +96,20 @@ int main(int argc, char *argv[]) {
 
     cout << "Balanced splay tree:\n";
     dsc::print_ascii_tree(balanced_tree.root());
+    cout << "\n";
+
+    cout << "Copying the balanced tree into a tree allocating from a monotonic buffer resource...\n";
+    auto resource    = std::pmr::monotonic_buffer_resource{};
+    auto copied_tree = dsc::pmr::splay_tree<int>{std::pmr::polymorphic_allocator<dsc::splay_tree_node<int>>{&resource}};
+    copied_tree      = dsc::pmr::splay_tree<int>{sorted};
+    auto deep_copy   = copied_tree;
+    cout << "Copy size => Expected: " << size << ", Actual: " << deep_copy.size() << "\n";
+    cout << "Kept the monotonic resource after move assignment => Expected: true, Actual: "
+         << (copied_tree.get_allocator().resource() == &resource ? "true" : "false") << "\n";
+    cout << "Copy uses the default resource => Expected: true, Actual: "
+         << (deep_copy.get_allocator().resource() == std::pmr::get_default_resource() ? "true" : "false") << "\n";
+    cout << "Copied splay tree:\n";
+    dsc::print_ascii_tree(deep_copy.root());
 
     return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include "dsc/segmented.hpp"
+#include "dsc/static_ring.hpp"
+
+using ring8 = dsc::static_ring<int, 8>;
+
+static_assert(std::is_trivially_copyable_v<ring8>);
+static_assert(std::is_standard_layout_v<ring8>);
+static_assert(std::random_access_iterator<ring8::iterator>);
+
+/** Pushes past the wrap point and sums what is left, entirely at compile time */
+constexpr auto wrapped_sum() -> int {
+    auto ring = ring8{};
+    for (int i=1; i<=8; i++) {
+        ring.push_back(i);
+    }
+    ring.pop_front();
+    ring.pop_front();
+    ring.push_back(9);
+    ring.push_front(0);
+
+    auto sum = 0;
+    for (auto v: ring) {
+        sum += v;
+    }
+    return sum;
+}
+
+/** Returns how many of 10 pushes a ring of 8 accepts */
+constexpr auto accepted_pushes() -> int {
+    auto ring     = ring8{};
+    auto accepted = 0;
+    for (int i=0; i<10; i++) {
+        accepted += ring.try_push_back(i);
+    }
+    return accepted;
+}
+
+static_assert(wrapped_sum() == 3+4+5+6+7+8+9);
+static_assert(accepted_pushes() == 8);
+
+int main() {
+    std::cout << "Compile time wrapped sum => Expected: 42, Actual: " << wrapped_sum() << "\n";
+    std::cout << "Accepted pushes          => Expected: 8,  Actual: " << accepted_pushes() << "\n\n";
+
+    std::cout << "Pushing 1..6 with push front/back onto static ring of strings...\n";
+    auto ring = dsc::static_ring<std::string, 8>{};
+    for (int i=1; i<=3; i++) {
+        ring.push_back(std::to_string(i+3));
+        ring.push_front(std::to_string(4-i));
+    }
+    std::cout << "Values: ";
+    for (auto& v: ring) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "try_push_back 7, 8, 9 => Expected: 1 1 0, Actual: " << ring.try_push_back("7") << " "
+              << ring.try_push_back("8") << " " << ring.try_push_back("9") << "\n";
+    std::cout << "Full => Expected: true, Actual: " << (ring.full() ? "true" : "false") << "\n";
+    std::cout << "Popping front and back => Expected: 1 8, Actual: " << ring.pop_front_get() << " " << ring.pop_back_get() << "\n\n";
+
+    std::cout << "Sharing a static ring between processes through shared memory...\n";
+    void* shared = mmap(nullptr, sizeof(ring8), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    auto* shared_ring = new (shared) ring8{};
+
+    auto pid = fork();
+    if (pid == 0) {
+        for (int i=10; i<=50; i+=10) {
+            shared_ring->push_back(i);
+        }
+        _exit(0);
+    }
+    waitpid(pid, nullptr, 0);
+
+    std::cout << "Values pushed by child => Expected: 10 20 30 40 50, Actual: ";
+    for (auto v: *shared_ring) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n";
+    std::cout << "accumulate => Expected: 150, Actual: " << dsc::accumulate(*shared_ring, 0) << "\n";
+    munmap(shared, sizeof(ring8));
+}
@@ -0,0 +1,120 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <dsc/heap.hpp>
+#include <dsc/topk_heap.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const CHUNK   = 1 << 16;
+auto const EVENTS  = 1600 * CHUNK;
+auto const THREADS = 4;
+auto const K       = 1000;
+
+using top_t = dsc::topk_heap<std::uint64_t, K>;
+
+/** Fills chunk with scores from a 64 bit linear congruential generator */
+auto next_chunk(std::vector<std::uint64_t>& chunk, std::uint64_t& state) -> void {
+    for (auto& v: chunk) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        v     = state >> 16;
+    }
+}
+
+/** Streams count scores in chunks, passing each to consume, and returns the seconds spent in consume */
+template<typename F>
+auto stream(std::uint64_t count, std::uint64_t seed, F consume) -> double {
+    auto chunk   = std::vector<std::uint64_t>(CHUNK);
+    auto seconds = 0.0;
+    for (std::uint64_t done=0; done < count; done += CHUNK) {
+        next_chunk(chunk, seed);
+        auto start = timer::now();
+        consume(chunk);
+        seconds += std::chrono::duration<double>(timer::now() - start).count();
+    }
+    return seconds;
+}
+
+/** Prints the time spent selecting, and the checksum of the selection */
+auto print_result(double seconds, std::uint64_t checksum) {
+    cout << "   Elapsed time: " << seconds << " (" << (EVENTS / seconds / 1e6) << " M events per second)\n";
+    cout << "   Checksum: " << checksum << "\n";
+}
+
+/** Sums the top K of a sorted selection */
+auto checksum(std::vector<std::uint64_t> const& sorted) -> std::uint64_t {
+    auto sum = std::uint64_t{0};
+    for (auto v: sorted) {
+        sum += v;
+    }
+    return sum;
+}
+
+auto main() -> int {
+    cout << "Top " << K << " of " << EVENTS << " scores by pushing every score onto dsc::heap and popping " << K << "...\n";
+    {
+        auto heap    = dsc::heap<std::uint64_t, dsc::max_heap>{};
+        auto seconds = stream(EVENTS, 42, [&](auto const& chunk) { heap.push_range(chunk); });
+        cout << "   Peak stored elements: " << heap.size() << "\n";
+        auto start = timer::now();
+        auto sum   = std::uint64_t{0};
+        for (auto i=0; i<K; i++) {
+            sum += heap.pop();
+        }
+        seconds += std::chrono::duration<double>(timer::now() - start).count();
+        print_result(seconds, sum);
+    }
+
+    cout << "Top " << K << " with topk_heap::push() per score...\n";
+    {
+        auto top     = top_t{};
+        auto seconds = stream(EVENTS, 42, [&](auto const& chunk) {
+            for (auto v: chunk) {
+                top.push(v);
+            }
+        });
+        print_result(seconds, checksum(top.sorted()));
+    }
+
+    cout << "Top " << K << " with topk_heap::push_range() per chunk of " << CHUNK << " scores...\n";
+    {
+        auto top     = top_t{};
+        auto seconds = stream(EVENTS, 42, [&](auto const& chunk) { top.push_range(chunk); });
+        print_result(seconds, checksum(top.sorted()));
+    }
+
+    cout << "Top " << K << " with one topk_heap per thread on " << THREADS << " threads, then merge_parallel()...\n";
+    {
+        auto parts   = std::vector<top_t>(THREADS);
+        auto start   = timer::now();
+        {
+            auto workers = std::vector<std::jthread>{};
+            for (auto t=0; t<THREADS; t++) {
+                workers.emplace_back([&parts, t] {
+                    // Each thread takes every THREADS'th chunk of the same stream, so the selection matches the others
+                    auto chunk = std::vector<std::uint64_t>(CHUNK);
+                    auto state = std::uint64_t{42};
+                    for (std::uint64_t done=0, idx=0; done < EVENTS; done += CHUNK, idx++) {
+                        next_chunk(chunk, state);
+                        if (idx % THREADS == static_cast<std::uint64_t>(t)) {
+                            parts[t].push_range(chunk);
+                        }
+                    }
+                });
+            }
+        }
+        auto merge_start = timer::now();
+        auto merged      = dsc::merge_parallel(parts);
+        auto end         = timer::now();
+        cout << "   Merge time: " << std::chrono::duration<double, std::micro>(end - merge_start).count() << " us\n";
+        cout << "   Elapsed time including generating every chunk on every thread: "
+             << std::chrono::duration<double>(end - start).count() << "\n";
+        cout << "   Checksum: " << checksum(merged.sorted()) << "\n";
+    }
+}
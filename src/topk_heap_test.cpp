@@ -0,0 +1,148 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "dsc/ring_vector.hpp"
+#include "dsc/topk_heap.hpp"
+
+/** Returns count values from a 64 bit linear congruential generator, reduced modulo range */
+auto random_values(std::size_t count, std::uint64_t seed, std::uint64_t range) -> std::vector<std::uint64_t> {
+    auto values = std::vector<std::uint64_t>(count);
+    for (auto& v: values) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        v    = (seed >> 16) % range;
+    }
+    return values;
+}
+
+/** Returns the k greatest values, best first, by sorting a copy */
+auto reference_topk(std::vector<std::uint64_t> values, std::size_t k) -> std::vector<std::uint64_t> {
+    std::ranges::sort(values, std::greater<>{});
+    values.resize(std::min(k, values.size()));
+    return values;
+}
+
+/** Memory resource which counts deallocations of blocks it did not hand out in foreign */
+class tracking_resource: public std::pmr::memory_resource {
+    std::set<void*> blocks_;
+
+    auto do_allocate(std::size_t bytes, std::size_t align) -> void* override {
+        auto p = std::pmr::new_delete_resource()->allocate(bytes, align);
+        blocks_.insert(p);
+        return p;
+    }
+    auto do_deallocate(void* p, std::size_t bytes, std::size_t align) -> void override {
+        foreign += blocks_.erase(p) == 0;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override { return this == &other; }
+
+ public:
+    int foreign = 0;
+};
+
+int main() {
+    std::cout << "Keeping the top 3 of 5 1 9 3 7 8 2...\n";
+    auto top3 = dsc::topk_heap<int, 3>{};
+    for (int v: {5, 1, 9, 3, 7, 8, 2}) {
+        top3.push(v);
+    }
+    std::cout << "size() full()     => Expected: 3 true, Actual: " << top3.size() << " " << (top3.full() ? "true" : "false") << "\n";
+    std::cout << "threshold()       => Expected: 7, Actual: " << top3.threshold() << "\n";
+    std::cout << "push(6) kept      => Expected: false, Actual: " << (top3.push(6) ? "true" : "false") << "\n";
+    std::cout << "push(7) kept      => Expected: false, Actual: " << (top3.push(7) ? "true" : "false") << "\n";
+    std::cout << "admits(10)        => Expected: true, Actual: " << (top3.admits(10) ? "true" : "false") << "\n";
+    std::cout << "push(10) kept     => Expected: true, Actual: " << (top3.push(10) ? "true" : "false") << "\n";
+    std::cout << "sorted()          => Expected: 10 9 8, Actual: ";
+    for (auto v: top3.sorted()) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n\n";
+
+    std::cout << "Bottom 2 strings by length with a custom comparator...\n";
+    auto longer   = [](std::string const& a, std::string const& b) { return a.size() > b.size(); };
+    auto shortest = dsc::topk_heap<std::string, 2, decltype(longer)>{};
+    for (auto w: {"pomegranate", "fig", "banana", "kiwi", "pear"}) {
+        shortest.push(w);
+    }
+    std::cout << "sorted()          => Expected: fig kiwi, Actual: ";
+    for (auto const& w: shortest.sorted()) {
+        std::cout << w << " ";
+    }
+    std::cout << "\n\n";
+
+    std::cout << "Top 100 of 100000 values through push() and push_range()...\n";
+    auto values   = random_values(100'000, 42, 1'000'000'000);
+    auto expected = reference_topk(values, 100);
+    auto pushed   = dsc::topk_heap<std::uint64_t, 100>{};
+    for (auto v: values) {
+        pushed.push(v);
+    }
+    auto ranged   = dsc::topk_heap<std::uint64_t, 100>{};
+    ranged.push_range(values);
+    std::cout << "push() matches sort       => Expected: true, Actual: " << (pushed.sorted() == expected ? "true" : "false") << "\n";
+    std::cout << "push_range() matches sort => Expected: true, Actual: " << (ranged.sorted() == expected ? "true" : "false") << "\n";
+
+    auto ascending = values;
+    std::ranges::sort(ascending);
+    auto rising    = dsc::topk_heap<std::uint64_t, 100>{};
+    rising.push_range(ascending);
+    std::cout << "Ascending input, every block beats the threshold => Expected: true, Actual: "
+              << (rising.sorted() == expected ? "true" : "false") << "\n";
+
+    auto ring = dsc::ring_vector<std::uint64_t>{};
+    for (auto v: values) {
+        ring.push_back(v);
+    }
+    for (auto i=0; i<1000; i++) {
+        ring.push_back(ring.front());
+        ring.pop_front();
+    }
+    auto segmented = dsc::topk_heap<std::uint64_t, 100>{};
+    segmented.push_range(ring);
+    std::cout << "Wrapped ring_vector matches sort => Expected: true, Actual: "
+              << (segmented.sorted() == expected ? "true" : "false") << "\n";
+
+    auto few = dsc::topk_heap<std::uint64_t, 100>{};
+    few.push_range(std::vector<std::uint64_t>{3, 1, 2});
+    std::cout << "Fewer than K values => Expected: 3 2 1, Actual: ";
+    for (auto v: few.sorted()) {
+        std::cout << v << " ";
+    }
+    std::cout << "\n\n";
+
+    std::cout << "Merging 7 per thread top 50s of overlapping values in parallel...\n";
+    auto parts  = std::vector<dsc::topk_heap<std::uint64_t, 50>>(7);
+    auto all    = std::vector<std::uint64_t>{};
+    for (auto p=0u; p<parts.size(); p++) {
+        auto slice = random_values(10'000, p + 1, 100'000);
+        parts[p].push_range(slice);
+        all.insert(all.end(), slice.begin(), slice.end());
+    }
+    auto copy = parts[0];
+    copy.merge(parts[1]);
+    auto merged = dsc::merge_parallel(parts);
+    std::cout << "Merged matches sort  => Expected: true, Actual: " << (merged.sorted() == reference_topk(all, 50) ? "true" : "false") << "\n";
+    std::cout << "Copy merge size      => Expected: 50, Actual: " << copy.size() << "\n";
+
+    auto resource_a = tracking_resource{};
+    auto resource_b = tracking_resource{};
+    {
+        auto small = dsc::pmr::topk_heap<std::uint64_t, 50>{&resource_a};
+        auto large = dsc::pmr::topk_heap<std::uint64_t, 50>{&resource_b};
+        small.push_range(std::vector<std::uint64_t>{1, 2});
+        large.push_range(random_values(100, 1, 1000));
+        small.merge(std::move(large));
+        std::cout << "Merge across resources size => Expected: 50 0, Actual: " << small.size() << " " << large.size() << "\n";
+    }
+    std::cout << "Arrays freed by their resource => Expected: 0 0, Actual: " << resource_a.foreign << " " << resource_b.foreign << "\n";
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include <dsc/ring_vector.hpp>
+#include <dsc/windowed_aggregate.hpp>
+
+using std::cout;
+using timer = std::chrono::high_resolution_clock;
+
+auto const TICKS       = 1 << 22;
+auto const SCAN_VALUES = 1ll << 28;
+auto rd                = std::random_device{};
+auto gen               = std::mt19937 {rd()};
+
+/** Returns nanoseconds per tick for the given number of ticks since start */
+auto ns_per_tick(timer::time_point start, long long ticks) -> double {
+    auto end = timer::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()) / static_cast<double>(ticks);
+}
+
+/** Pushes TICKS values through a full window of an aggregate, reading the result after every push */
+template<typename Aggregate, typename Read>
+auto time_aggregate(Aggregate& agg, std::vector<int> const& values, Read read) -> double {
+    volatile long long sink = 0;
+    for (std::size_t i=0; i < agg.window(); i++) {
+        agg.push(values[i % values.size()]);
+    }
+
+    auto start = timer::now();
+    for (auto i=0; i<TICKS; i++) {
+        agg.push(values[static_cast<std::size_t>(i) % values.size()]);
+        sink = sink + read(agg);
+    }
+    return ns_per_tick(start, TICKS);
+}
+
+/** Keeps a plain ring_vector window and rescans it after every push. Fewer ticks are run for large windows so each
+ *  case scans about SCAN_VALUES values. */
+template<typename Scan>
+auto time_rescan(std::size_t window, std::vector<int> const& values, Scan scan) -> double {
+    volatile long long sink = 0;
+    auto vec   = dsc::ring_vector<int>{window};
+    auto ticks = std::max(16ll, SCAN_VALUES / static_cast<long long>(window));
+    for (std::size_t i=0; i < window; i++) {
+        vec.push_back(values[i % values.size()]);
+    }
+
+    auto start = timer::now();
+    for (auto i=0ll; i<ticks; i++) {
+        vec.pop_front();
+        vec.push_back(values[static_cast<std::size_t>(i) % values.size()]);
+        sink = sink + scan(vec);
+    }
+    return ns_per_tick(start, ticks);
+}
+
+auto main() -> int {
+    auto next   = std::uniform_int_distribution<>(-1000, 1000);
+    auto values = std::vector<int>(1 << 20);
+    std::generate(values.begin(), values.end(), [&] { return next(gen); });
+
+    for (auto window: {std::size_t{1000}, std::size_t{10000}, std::size_t{100000}, std::size_t{1000000}, std::size_t{10000000}}) {
+        cout << "Window of " << window << " ints, ns per push and read\n";
+
+        auto min = dsc::windowed_aggregate<int, dsc::window_min>{window};
+        cout << "   Min, monotonic deque:      " << time_aggregate(min, values, [](auto& a) { return a.value(); }) << "\n";
+        cout << "   Min, rescan:               " << time_rescan(window, values, [](auto& v) {
+            return *std::min_element(v.begin(), v.end());
+        }) << "\n";
+
+        auto sum = dsc::windowed_aggregate<long long, std::plus<>>{window};
+        cout << "   Sum, two stacks:           " << time_aggregate(sum, values, [](auto& a) { return a.value(); }) << "\n";
+        auto moments = dsc::windowed_aggregate<int, dsc::window_moments>{window};
+        cout << "   Sum and variance, moments: " << time_aggregate(moments, values, [](auto& a) {
+            return a.sum() + static_cast<long long>(a.variance());
+        }) << "\n";
+        cout << "   Sum, rescan:               " << time_rescan(window, values, [](auto& v) {
+            return std::accumulate(v.begin(), v.end(), 0ll);
+        }) << "\n";
+        cout << "\n";
+    }
+}
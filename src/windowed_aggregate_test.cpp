@@ -0,0 +1,96 @@
+// Copyright 2024 Nathaniel Mitchell
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "dsc/windowed_aggregate.hpp"
+
+/** Returns the gcd of two values, an associative op with no cheap inverse */
+struct gcd_op {
+    auto operator()(int a, int b) const -> int { return std::gcd(a, b); }
+};
+
+int main() {
+    std::cout << "Windowed min and max over 5 3 8 1 9 2 7 with window 3...\n";
+    auto min = dsc::windowed_aggregate<int, dsc::window_min>{3};
+    auto max = dsc::windowed_aggregate<int, dsc::window_max>{3};
+    std::cout << "Min => Expected: 5 3 3 1 1 1 2, Actual: ";
+    for (auto v: {5, 3, 8, 1, 9, 2, 7}) {
+        min.push(v);
+        std::cout << min.value() << " ";
+    }
+    std::cout << "\n";
+    std::cout << "Max => Expected: 5 5 8 8 9 9 9, Actual: ";
+    for (auto v: {5, 3, 8, 1, 9, 2, 7}) {
+        max.push(v);
+        std::cout << max.value() << " ";
+    }
+    std::cout << "\n";
+    std::cout << "Size => Expected: 3, Actual: " << max.size() << "\n\n";
+
+    std::cout << "Windowed moments over 2 4 4 4 5 5 7 9 with window 8, then evicting the first 4...\n";
+    auto moments = dsc::windowed_aggregate<int, dsc::window_moments>{8};
+    for (auto v: {2, 4, 4, 4, 5, 5, 7, 9}) {
+        moments.push(v);
+    }
+    std::cout << "Sum, mean, variance => Expected: 40 5 4, Actual: " << moments.sum() << " " << moments.mean() << " "
+              << moments.variance() << "\n";
+    for (int i=0; i<4; i++) {
+        moments.pop();
+    }
+    std::cout << "Sum, mean, variance => Expected: 26 6.5 2.75, Actual: " << moments.sum() << " " << moments.mean()
+              << " " << moments.variance() << "\n\n";
+
+    std::cout << "Windowed gcd over 12 18 24 7 14 21 with window 3...\n";
+    auto gcd = dsc::windowed_aggregate<int, gcd_op>{3};
+    std::cout << "Gcd => Expected: 12 6 6 1 1 7, Actual: ";
+    for (auto v: {12, 18, 24, 7, 14, 21}) {
+        gcd.push(v);
+        std::cout << gcd.value() << " ";
+    }
+    std::cout << "\n\n";
+
+    std::cout << "Comparing against a rescan of each window for 10000 random values, window 100...\n";
+    auto gen    = std::mt19937{42};
+    auto next   = std::uniform_int_distribution<>(-1000, 1000);
+    auto values = std::vector<int>(10000);
+    std::generate(values.begin(), values.end(), [&] { return next(gen); });
+
+    auto window      = 100ul;
+    auto rolling_min = dsc::windowed_aggregate<int, dsc::window_min>{window};
+    auto rolling_max = dsc::windowed_aggregate<int, dsc::window_max>{window};
+    auto rolling_sum = dsc::windowed_aggregate<long, std::plus<>>{window};
+    auto rolling_mom = dsc::windowed_aggregate<int, dsc::window_moments>{window};
+    auto mismatches  = 0;
+    auto worst_error = 0.0;
+    for (std::size_t i=0; i < values.size(); i++) {
+        rolling_min.push(values[i]);
+        rolling_max.push(values[i]);
+        rolling_sum.push(values[i]);
+        rolling_mom.push(values[i]);
+
+        auto first = values.begin() + static_cast<long>(i >= window ? i+1-window : 0);
+        auto last  = values.begin() + static_cast<long>(i+1);
+        auto sum   = std::accumulate(first, last, 0l);
+        auto mean  = static_cast<double>(sum) / static_cast<double>(last - first);
+        auto var   = 0.0;
+        for (auto it=first; it != last; ++it) {
+            var += (*it - mean) * (*it - mean);
+        }
+        var /= static_cast<double>(last - first);
+
+        mismatches += rolling_min.value() != *std::min_element(first, last);
+        mismatches += rolling_max.value() != *std::max_element(first, last);
+        mismatches += rolling_sum.value() != sum;
+        mismatches += rolling_mom.sum() != sum;
+        worst_error = std::max({worst_error, std::abs(rolling_mom.mean() - mean), std::abs(rolling_mom.variance() - var)});
+    }
+    std::cout << "Mismatches => Expected: 0, Actual: " << mismatches << "\n";
+    std::cout << "Mean and variance within 1e-6 => Expected: true, Actual: " << (worst_error < 1e-6 ? "true" : "false")
+              << "\n";
+}